@@ -24,6 +24,13 @@ export LC_ALL=C
   echo ')'
 ) > tests/unit/meson.build
 
+(
+  cd tests/bench
+  echo 'bench_files = files('
+  find -name '*.cpp' -printf '%P\n' | sort | sed "s|.*|'\0'|" | paste -sd,
+  echo ')'
+) > tests/bench/meson.build
+
 (
   cd programs
   find -name '*.cpp' -printf '%P\n' | sort | sed "s|\(.*\)\.cpp|executable('ndnph-\1', '\1.cpp', dependencies: [lib_dep])|"
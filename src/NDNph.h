@@ -18,17 +18,22 @@
 #include "ndnph/app/rdr.hpp"
 #include "ndnph/app/segment-consumer.hpp"
 #include "ndnph/app/segment-producer.hpp"
+#include "ndnph/core/chained-region.hpp"
 #include "ndnph/core/common.hpp"
 #include "ndnph/core/input-iterator-pointer-proxy.hpp"
 #include "ndnph/core/operators.hpp"
 #include "ndnph/core/printing.hpp"
+#include "ndnph/core/region-pool.hpp"
 #include "ndnph/core/region.hpp"
 #include "ndnph/core/simple-queue.hpp"
 #include "ndnph/face/bridge-transport.hpp"
 #include "ndnph/face/face.hpp"
 #include "ndnph/face/packet-handler.hpp"
+#include "ndnph/face/pending-interest-table.hpp"
+#include "ndnph/face/rtt-estimator.hpp"
 #include "ndnph/face/transport-force-endpointid.hpp"
 #include "ndnph/face/transport-rxqueue.hpp"
+#include "ndnph/face/transport-txqueue.hpp"
 #include "ndnph/face/transport.hpp"
 #include "ndnph/keychain/certificate.hpp"
 #include "ndnph/keychain/digest.hpp"
@@ -46,6 +51,7 @@
 #include "ndnph/packet/interest.hpp"
 #include "ndnph/packet/lp.hpp"
 #include "ndnph/packet/nack.hpp"
+#include "ndnph/packet/name-hash.hpp"
 #include "ndnph/packet/name.hpp"
 #include "ndnph/packet/sig-info.hpp"
 #include "ndnph/store/kv.hpp"
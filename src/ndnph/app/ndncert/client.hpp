@@ -338,12 +338,16 @@ private:
     , m_cb(opts.cb)
     , m_cbCtx(opts.ctx)
   {
-    sendNewRequest(opts.pub);
+    prepareNewRequest(opts.pub);
   }
 
   void loop() final
   {
     switch (m_state) {
+      case State::SendNewRequest: {
+        sendNewRequest();
+        break;
+      }
       case State::SendChallengeRequest: {
         sendChallengeRequest();
         break;
@@ -380,25 +384,67 @@ private:
       return false;
     }
 
+    bool accepted = false;
     switch (m_state) {
       case State::WaitNewResponse: {
-        return handleNewResponse(data);
+        accepted = handleNewResponse(data);
+        break;
       }
       case State::WaitChallengeResponse: {
-        return handleChallengeResponse(data);
+        accepted = handleChallengeResponse(data);
+        break;
       }
       case State::WaitIssuedCert: {
-        return handleIssuedCert(data);
+        accepted = handleIssuedCert(data);
+        break;
       }
       default:
         break;
     }
-    return false;
+    if (accepted) {
+      m_canRetx = true;
+    }
+    return accepted;
   }
 
-  void sendNewRequest(const EcPublicKey& pub)
+  /**
+   * @brief Handle Nack of the pending request.
+   *
+   * The first Duplicate Nack of each step causes the request to be re-signed and retransmitted
+   * with a fresh nonce. Other Nacks fail the procedure without waiting for timeout.
+   */
+  bool processNack(Nack nack) final
+  {
+    if (!m_pending.matchPitToken()) {
+      return false;
+    }
+
+    State retxState = State::Failure;
+    switch (m_state) {
+      case State::WaitNewResponse:
+        retxState = State::SendNewRequest;
+        break;
+      case State::WaitChallengeResponse:
+        retxState = State::SendChallengeRequest;
+        break;
+      case State::WaitIssuedCert:
+        retxState = State::FetchIssuedCert;
+        break;
+      default:
+        return false;
+    }
+
+    if (nack.getReason() == NackReason::Duplicate && m_canRetx) {
+      m_canRetx = false;
+      m_state = retxState;
+    } else {
+      m_state = State::Failure;
+    }
+    return true;
+  }
+
+  void prepareNewRequest(const EcPublicKey& pub)
   {
-    StaticRegion<2048> region;
     GotoState gotoState(this);
     int res = mbedtls_ecdh_gen_public(mbedtls::P256::group(), &m_ecdhPvt, &m_newRequest.ecdhPub,
                                       mbedtls::rng, nullptr);
@@ -418,6 +464,14 @@ private:
       return;
     }
 
+    gotoState(State::SendNewRequest);
+    sendNewRequest();
+  }
+
+  void sendNewRequest()
+  {
+    StaticRegion<2048> region;
+    GotoState gotoState(this);
     m_pending.send(m_newRequest.toInterest(region, m_profile, m_signingPolicy, m_pvt)) &&
       gotoState(State::WaitNewResponse);
   }
@@ -526,6 +580,7 @@ private:
 private:
   OutgoingPendingInterest m_pending;
   State m_state = State::SendNewRequest;
+  bool m_canRetx = true;
 
   const CaProfile& m_profile;
   ChallengeList m_challenges;
@@ -2,6 +2,7 @@
 #define NDNPH_APP_PING_CLIENT_HPP
 
 #include "../face/packet-handler.hpp"
+#include "../face/rtt-estimator.hpp"
 #include "../port/clock/port.hpp"
 
 namespace ndnph {
@@ -12,6 +13,9 @@ namespace ndnph {
  * This is a simple ping client implementation that can only keep one pending Interest.
  * After sending a probe Interest, responses to previous Interests are no longer accepted.
  * Therefore, interval must be greater than RTT, otherwise this client cannot receive any Data.
+ *
+ * Upon a Duplicate Nack, the probe is retransmitted once with a fresh nonce. Upon a Congestion
+ * Nack, the next probe is deferred by one interval.
  */
 class PingClient : public PacketHandler
 {
@@ -35,6 +39,7 @@ public:
   {
     uint32_t nTxInterests = 0;
     uint32_t nRxData = 0;
+    uint32_t nRxNacks = 0;
   };
 
   Counters readCounters() const
@@ -42,6 +47,12 @@ public:
     return m_cnt;
   }
 
+  /** @brief Access RTT estimator, which is updated upon each Data reply. */
+  const RttEstimator& getRttEstimator() const
+  {
+    return m_rtt;
+  }
+
 private:
   void loop() final
   {
@@ -49,14 +60,16 @@ private:
     if (port::Clock::isBefore(now, m_next)) {
       return;
     }
-    sendInterest();
     m_next = port::Clock::add(now, m_interval);
+    ++m_seqNum;
+    m_canRetx = true;
+    sendInterest();
   }
 
   bool sendInterest()
   {
     StaticRegion<1024> region;
-    Component seqNumComp = Component::from(region, TT::GenericNameComponent, tlv::NNI8(++m_seqNum));
+    Component seqNumComp = Component::from(region, TT::GenericNameComponent, tlv::NNI8(m_seqNum));
     assert(!!seqNumComp);
     Name name = m_prefix.append(region, { seqNumComp });
     assert(!!name);
@@ -66,6 +79,7 @@ private:
     interest.setName(name);
     interest.setMustBeFresh(true);
 
+    m_sendTime = port::Clock::now();
     if (!send(interest)) {
       return false;
     }
@@ -73,22 +87,55 @@ private:
     return true;
   }
 
-  bool processData(Data data) final
+  /** @brief Extract sequence number from Data or Interest name. */
+  bool parseSeqNum(const Name& name, uint64_t& seqNum) const
   {
-    const Name& dataName = data.getName();
-    if (!m_prefix.isPrefixOf(dataName) || m_prefix.size() + 1 != dataName.size()) {
+    if (!m_prefix.isPrefixOf(name) || m_prefix.size() + 1 != name.size()) {
       return false;
     }
-    Component lastComp = dataName[-1];
+    Component lastComp = name[-1];
     Decoder::Tlv d;
     Decoder::readTlv(d, lastComp.tlv(), lastComp.tlv() + lastComp.size());
+    return tlv::NNI8::decode(d, seqNum);
+  }
+
+  bool processData(Data data) final
+  {
     uint64_t seqNum = 0;
-    if (!tlv::NNI8::decode(d, seqNum)) {
+    if (!parseSeqNum(data.getName(), seqNum)) {
       return false;
     }
 
     if (m_seqNum == seqNum) {
       ++m_cnt.nRxData;
+      m_rtt.addMeasurement(m_sendTime);
+    }
+    return true;
+  }
+
+  bool processNack(Nack nack) final
+  {
+    uint64_t seqNum = 0;
+    if (!parseSeqNum(nack.getInterest().getName(), seqNum)) {
+      return false;
+    }
+    if (m_seqNum != seqNum) {
+      return true;
+    }
+
+    ++m_cnt.nRxNacks;
+    switch (nack.getReason()) {
+      case NackReason::Duplicate:
+        if (m_canRetx) {
+          m_canRetx = false;
+          sendInterest();
+        }
+        break;
+      case NackReason::Congestion:
+        m_next = port::Clock::add(m_next, m_interval);
+        break;
+      default:
+        break;
     }
     return true;
   }
@@ -98,7 +145,10 @@ private:
   uint64_t m_seqNum = 0;
   int m_interval = 1000;
   port::Clock::Time m_next;
+  port::Clock::Time m_sendTime;
   Counters m_cnt;
+  RttEstimator m_rtt;
+  bool m_canRetx = false;
 };
 
 } // namespace ndnph
@@ -6,7 +6,12 @@
 
 namespace ndnph {
 
-/** @brief Respond to every incoming Interest with empty Data. */
+/**
+ * @brief Respond to every incoming Interest with empty Data.
+ *
+ * The Data is created and encoded in the region of the Interest. If the face receives in place,
+ * the transport should reserve enough rxRoom for the reply.
+ */
 class PingServer : public PacketHandler
 {
 public:
@@ -14,11 +19,15 @@ public:
    * @brief Constructor.
    * @param prefix name prefix to serve. It should have 'ping' suffix.
    * @param face face for communication.
+   *
+   * If the face has prefix index enabled, the prefix is registered there.
    */
   explicit PingServer(Name prefix, Face& face)
     : PacketHandler(face)
     , m_prefix(std::move(prefix))
-  {}
+  {
+    face.addPrefix(*this, m_prefix);
+  }
 
 private:
   bool processInterest(Interest interest) final
@@ -27,12 +36,16 @@ private:
       return false;
     }
 
-    StaticRegion<1024> region;
+    Region& region = regionOf(interest);
+    auto cp = region.mark();
     Data data = region.create<Data>();
-    assert(!!data);
+    if (!data) {
+      return false;
+    }
     data.setName(interest.getName());
     data.setFreshnessPeriod(1);
     reply(data.sign(DigestKey::get()));
+    region.restore(cp);
     return true;
   }
 
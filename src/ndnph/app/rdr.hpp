@@ -2,6 +2,7 @@
 #define NDNPH_APP_RDR_HPP
 
 #include "../face/packet-handler.hpp"
+#include "../face/rtt-estimator.hpp"
 #include "../keychain/digest.hpp"
 #include "../keychain/null.hpp"
 
@@ -164,6 +165,9 @@ private:
 /**
  * @brief Consumer of RDR metadata packet.
  * @sa https://redmine.named-data.net/projects/ndn-tlv/wiki/RDR
+ *
+ * A Nack fails the request without waiting for timeout, except that the first Duplicate Nack
+ * causes a retransmission with a fresh nonce.
  */
 class RdrMetadataConsumer : public PacketHandler
 {
@@ -174,6 +178,15 @@ public:
   {
     const PublicKey& verifier;
     uint16_t interestLifetime;
+
+    /**
+     * @brief RTT estimator, may be nullptr.
+     *
+     * If specified, RTO is updated by each reply, and backs off upon each timeout or Congestion
+     * Nack. Since this consumer does not retransmit, the request still times out after
+     * interestLifetime. The estimator may be shared among consumers that reach the same producer.
+     */
+    RttEstimator* rtt;
   };
 
   explicit RdrMetadataConsumer(Face& face, const Options& opts)
@@ -181,12 +194,14 @@ public:
     , m_pending(this)
     , m_verifier(opts.verifier)
     , m_interestLifetime(opts.interestLifetime)
+    , m_rtt(opts.rtt)
   {}
 
   explicit RdrMetadataConsumer(Face& face)
     : RdrMetadataConsumer(face, Options{
                                   .verifier = NullKey::get(),
                                   .interestLifetime = 1000,
+                                  .rtt = nullptr,
                                 })
   {}
 
@@ -197,7 +212,13 @@ public:
     m_rdrPrefix = detail::stripMetadataComponent(rdrPrefix);
     m_cb = cb;
     m_ctx = ctx;
+    m_canRetx = true;
+    sendInterest();
+  }
 
+private:
+  void sendInterest()
+  {
     StaticRegion<1024> region;
     auto interest = region.create<Interest>();
     assert(!!interest);
@@ -211,7 +232,6 @@ public:
     }
   }
 
-private:
   void invokeCallback(Data data)
   {
     if (m_cb != nullptr) {
@@ -222,7 +242,10 @@ private:
 
   void loop() final
   {
-    if (m_pending.expired()) {
+    if (m_cb != nullptr && m_pending.expired()) {
+      if (m_rtt != nullptr) {
+        m_rtt->backoff();
+      }
       invokeCallback(Data());
     }
   }
@@ -233,6 +256,9 @@ private:
         data.getName()[m_rdrPrefix.size()] != getMetadataComponent()) {
       return false;
     }
+    if (m_rtt != nullptr && m_cb != nullptr) {
+      m_rtt->addMeasurement(m_pending.getSendTime());
+    }
 
     if (!data.verify(m_verifier)) {
       invokeCallback(Data());
@@ -242,13 +268,44 @@ private:
     return true;
   }
 
+  bool processNack(Nack nack) final
+  {
+    const Name& name = nack.getInterest().getName();
+    if (m_cb == nullptr || !m_pending.matchPitToken() ||
+        name.size() != m_rdrPrefix.size() + 1 || !m_rdrPrefix.isPrefixOf(name) ||
+        name[-1] != getMetadataComponent()) {
+      return false;
+    }
+
+    switch (nack.getReason()) {
+      case NackReason::Duplicate:
+        if (m_canRetx) {
+          m_canRetx = false;
+          sendInterest();
+          return true;
+        }
+        break;
+      case NackReason::Congestion:
+        if (m_rtt != nullptr) {
+          m_rtt->backoff();
+        }
+        break;
+      default:
+        break;
+    }
+    invokeCallback(Data());
+    return true;
+  }
+
 private:
   OutgoingPendingInterest m_pending;
   const PublicKey& m_verifier;
   uint16_t m_interestLifetime = 0;
+  RttEstimator* m_rtt = nullptr;
   Name m_rdrPrefix;
   Callback m_cb = nullptr;
   void* m_ctx = nullptr;
+  bool m_canRetx = false;
 };
 
 } // namespace rdr
@@ -2,6 +2,8 @@
 #define NDNPH_APP_SEGMENT_CONSUMER_HPP
 
 #include "../face/packet-handler.hpp"
+#include "../face/pending-interest-table.hpp"
+#include "../face/rtt-estimator.hpp"
 #include "../keychain/null.hpp"
 #include "../port/clock/port.hpp"
 
@@ -17,8 +19,15 @@ public:
     /** @brief Maximum retransmission of an Interest, not counting initial Interest. */
     int retxLimit = 5;
 
-    /** @brief Delay in milliseconds before retransmission. */
-    int retxDelay = 500;
+    /**
+     * @brief Retransmission timeout in milliseconds.
+     *
+     * If zero, retransmission timeout is adaptive, as computed by RttEstimator.
+     */
+    int retxDelay = 0;
+
+    /** @brief RttEstimator options, used if @c retxDelay is zero. */
+    RttEstimator::Options rtt;
   };
 
   /**
@@ -31,6 +40,7 @@ public:
     : PacketHandler(face)
     , m_region(region)
     , m_opts(std::move(opts))
+    , m_rtt(m_opts.rtt)
   {}
 
   explicit SegmentConsumerBase(Face& face, Region& region)
@@ -112,6 +122,109 @@ public:
     setSegmentCallback(SaveDest::accumulate, &dest);
   }
 
+  /**
+   * @brief Destination and context of streaming payload.
+   *
+   * Unlike SaveDest, payload is not accumulated in memory. Each segment payload is passed to a
+   * write function along with its offset in the content, so that content larger than available
+   * memory can be saved to a file, such as via port::FileWriter.
+   * Segments arrive in order, so that memory usage is bounded by the consumer's reorder buffer.
+   * If the write function fails, the consumer is stopped, so that the rest of the content is
+   * not fetched.
+   */
+  class StreamDest
+  {
+  public:
+    /**
+     * @brief Write function.
+     * @param ctx context pointer.
+     * @param offset offset of @p chunk in the content.
+     * @param chunk payload of a segment.
+     * @return whether success.
+     */
+    using WriteCallback = bool (*)(void* ctx, uint64_t offset, tlv::Value chunk);
+
+    /**
+     * @brief Completion function.
+     * @param ctx context pointer.
+     * @param ok whether the content has been completely written.
+     * @param size content size if @p ok is true, otherwise number of written octets.
+     */
+    using CompleteCallback = void (*)(void* ctx, bool ok, uint64_t size);
+
+    explicit StreamDest(WriteCallback writeCb, void* writeCtx,
+                        CompleteCallback completeCb = nullptr, void* completeCtx = nullptr)
+      : m_writeCb(writeCb)
+      , m_writeCtx(writeCtx)
+      , m_completeCb(completeCb)
+      , m_completeCtx(completeCtx)
+    {}
+
+    static void accumulate(void* self0, uint64_t, Data data)
+    {
+      reinterpret_cast<StreamDest*>(self0)->accumulate(data);
+    }
+
+  private:
+    void accumulate(Data data)
+    {
+      if (hasError || isCompleted) {
+        return;
+      }
+      if (!data) {
+        complete(false);
+        return;
+      }
+      auto content = data.getContent();
+      if (!m_writeCb(m_writeCtx, length, content)) {
+        complete(false);
+        if (m_consumer != nullptr) {
+          m_consumer->stop();
+        }
+        return;
+      }
+      length += content.size();
+      if (data.getIsFinalBlock()) {
+        complete(true);
+      }
+    }
+
+    void complete(bool ok)
+    {
+      isCompleted = ok;
+      hasError = !ok;
+      if (m_completeCb != nullptr) {
+        m_completeCb(m_completeCtx, ok, length);
+      }
+    }
+
+  private:
+    SegmentConsumerBase* m_consumer = nullptr;
+    WriteCallback m_writeCb = nullptr;
+    void* m_writeCtx = nullptr;
+    CompleteCallback m_completeCb = nullptr;
+    void* m_completeCtx = nullptr;
+    friend SegmentConsumerBase;
+
+  public:
+    uint64_t length = 0;
+    bool isCompleted = false;
+    bool hasError = false;
+  };
+
+  /**
+   * @brief Stream content to destination.
+   * @param dest streaming destination, must be kept alive while SegmentConsumer is running.
+   *
+   * This should be invoked before @c start() .
+   * This cannot be used together with SegmentCallback.
+   */
+  void saveTo(StreamDest& dest)
+  {
+    dest.m_consumer = this;
+    setSegmentCallback(StreamDest::accumulate, &dest);
+  }
+
   /**
    * @brief Start fetching content under given prefix.
    *
@@ -124,6 +237,7 @@ public:
     m_segment = 0;
     m_retxRemain = m_opts.retxLimit;
     m_nextSend = port::Clock::now();
+    doStart();
   }
 
   /**
@@ -134,6 +248,7 @@ public:
   void stop()
   {
     m_running = false;
+    doStop();
   }
 
   /** @brief Determine whether fetching is in progress (not completed or failed). */
@@ -142,6 +257,23 @@ public:
     return m_running;
   }
 
+  /**
+   * @brief Access RTT estimator.
+   *
+   * RTT measurements are retained across fetches.
+   */
+  const RttEstimator& getRttEstimator() const
+  {
+    return m_rtt;
+  }
+
+private:
+  /** @brief Override to reset algorithm state when fetching starts. */
+  virtual void doStart() {}
+
+  /** @brief Override to release algorithm state when fetching is stopped. */
+  virtual void doStop() {}
+
 protected:
   void invokeCallback(Data data)
   {
@@ -150,9 +282,16 @@ protected:
     }
   }
 
+  /** @brief Return retransmission timeout in milliseconds. */
+  int getRetxTimeout() const
+  {
+    return m_opts.retxDelay > 0 ? m_opts.retxDelay : m_rtt.getRto();
+  }
+
 protected:
   Region& m_region;
   Options m_opts;
+  RttEstimator m_rtt;
   SegmentCallback m_cb = nullptr;
   void* m_cbCtx = nullptr;
   Name m_prefix;
@@ -162,7 +301,13 @@ protected:
   bool m_running = false;
 };
 
-/** @brief Consumer of segmented object, using a stop-and-wait algorithm. */
+/**
+ * @brief Consumer of segmented object, using a stop-and-wait algorithm.
+ *
+ * A Nack of the outstanding Interest causes immediate retransmission, except that a Congestion
+ * Nack backs off RTO and delays retransmission by RTO, and a NoRoute Nack fails the fetching.
+ * A Nack carrying the PIT token of an earlier transmission is ignored.
+ */
 template<typename SegmentConvention = convention::Segment>
 class BasicSegmentConsumer : public SegmentConsumerBase
 {
@@ -182,14 +327,18 @@ private:
       invokeCallback(Data());
       return;
     }
+    if (m_retxRemain < m_opts.retxLimit - 1 && !m_nackRetx) { // previous Interest timed out
+      m_rtt.backoff();
+    }
+    m_nackRetx = false;
 
     m_region.reset();
     Interest interest = m_region.create<Interest>();
     assert(!!interest);
     interest.setName(m_prefix.append<SegmentConvention>(m_region, m_segment));
-    send(interest);
-
-    m_nextSend = port::Clock::add(now, m_opts.retxDelay);
+    m_sendTime = now;
+    m_nextSend = port::Clock::add(now, getRetxTimeout());
+    send(interest, WithPitToken(++m_pitToken));
   }
 
   bool processData(Data data) final
@@ -204,6 +353,9 @@ private:
     if (segment != m_segment) {
       return false;
     }
+    if (m_retxRemain == m_opts.retxLimit - 1) { // Karn's algorithm: no retransmission
+      m_rtt.addMeasurement(m_sendTime);
+    }
 
     invokeCallback(data);
 
@@ -216,10 +368,483 @@ private:
     }
     return true;
   }
+
+  bool processNack(Nack nack) final
+  {
+    const Name& name = nack.getInterest().getName();
+    auto lastComp = name[-1];
+    if (!m_running || name.size() != m_prefix.size() + 1 || !m_prefix.isPrefixOf(name) ||
+        !lastComp.is<SegmentConvention>() || lastComp.as<SegmentConvention>() != m_segment) {
+      return false;
+    }
+    const PacketInfo* pi = getCurrentPacketInfo();
+    if (pi != nullptr && pi->pitToken != 0 && pi->pitToken != m_pitToken) {
+      return true; // Nack of an earlier transmission
+    }
+
+    auto now = port::Clock::now();
+    switch (nack.getReason()) {
+      case NackReason::Duplicate: // retransmit with a fresh nonce, without RTO backoff
+        m_nackRetx = true;
+        m_nextSend = now;
+        break;
+      case NackReason::NoRoute: // retransmission would not help
+        m_running = false;
+        invokeCallback(Data());
+        break;
+      case NackReason::Congestion: // back off, and retransmit after RTO
+        m_rtt.backoff();
+        m_nackRetx = true;
+        m_nextSend = port::Clock::add(now, getRetxTimeout());
+        break;
+      default: // retransmit now, with RTO backoff as upon timeout
+        m_nextSend = now;
+        break;
+    }
+    return true;
+  }
+
+private:
+  port::Clock::Time m_sendTime;
+  uint64_t m_pitToken = 0;
+  bool m_nackRetx = false;
 };
 
 using SegmentConsumer = BasicSegmentConsumer<>;
 
+/**
+ * @brief Consumer of segmented object, using a window of pipelined Interests.
+ *
+ * Up to a congestion window of Interests are outstanding at a time. The window follows AIMD:
+ * it grows by one per Data during slow start and by one per window afterwards, and halves upon
+ * an Interest timeout or a Congestion Nack, at most once per window of Interests. A Duplicate
+ * Nack causes immediate retransmission, and a NoRoute Nack fails the fetching. Data may arrive
+ * out of order; such Data is copied into a reorder buffer, and the SegmentCallback is invoked in
+ * segment order. Out of order Data that does not fit in the reorder buffer is dropped, and its
+ * segment is requested again when it is next to be delivered.
+ */
+template<typename SegmentConvention = convention::Segment>
+class BasicPipelinedSegmentConsumer : public SegmentConsumerBase
+{
+public:
+  struct Options : SegmentConsumerBase::Options
+  {
+    /** @brief Initial congestion window, in number of Interests. */
+    uint16_t initCwnd = 2;
+
+    /** @brief Maximum congestion window, which is also the reorder buffer capacity. */
+    uint16_t maxCwnd = 32;
+
+    /**
+     * @brief Maximum encoded length of Data that can be held in the reorder buffer.
+     *
+     * Longer Data can still be delivered in order, at the cost of a retransmission.
+     */
+    size_t maxDataLen = 1500;
+  };
+
+  /**
+   * @brief Constructor.
+   * @param face face for communication.
+   * @param region region for Interest encoding and Data decoding; may be shared.
+   * @param opts options.
+   */
+  explicit BasicPipelinedSegmentConsumer(Face& face, Region& region, const Options& opts)
+    : SegmentConsumerBase(face, region, opts)
+    , m_capacity(std::max<uint16_t>(opts.maxCwnd, 1))
+    , m_initCwnd(std::min<uint16_t>(std::max<uint16_t>(opts.initCwnd, 1), m_capacity))
+    , m_maxDataLen(opts.maxDataLen)
+    , m_slots(new Slot[m_capacity])
+    , m_buf(new uint8_t[m_maxDataLen * m_capacity])
+    , m_pitRegion(sizeof(PendingInterestTable::Entry) * m_capacity + 1024)
+    , m_pit(m_pitRegion, m_capacity)
+  {
+    assert(!!m_pit);
+    for (uint16_t i = 0; i < m_capacity; ++i) {
+      m_slots[i].owner = this;
+    }
+  }
+
+  explicit BasicPipelinedSegmentConsumer(Face& face, Region& region)
+    : BasicPipelinedSegmentConsumer(face, region, Options())
+  {}
+
+  /** @brief Return current congestion window. */
+  uint16_t getCwnd() const
+  {
+    return m_cwnd;
+  }
+
+  /** @brief Return number of outstanding Interests. */
+  uint16_t countInFlight() const
+  {
+    return m_nInFlight;
+  }
+
+private:
+  enum class SlotState : uint8_t
+  {
+    Idle,
+    Pending,
+    Retx,
+    Deferred, ///< Data did not fit in reorder buffer, request again when next to deliver
+    Received,
+  };
+
+  struct Slot
+  {
+    BasicPipelinedSegmentConsumer* owner = nullptr;
+    PendingInterestTable::Entry* pit = nullptr;
+    uint64_t segment = 0;
+    size_t dataOffset = 0;
+    size_t dataLen = 0;
+    int retxRemain = 0;
+    SlotState state = SlotState::Idle;
+  };
+
+  Slot& slotOf(uint64_t segment)
+  {
+    return m_slots[segment % m_capacity];
+  }
+
+  uint8_t* bufOf(const Slot& slot)
+  {
+    return &m_buf[m_maxDataLen * (&slot - m_slots.get())];
+  }
+
+  void doStart() final
+  {
+    cancelAll();
+    m_nextNew = 0;
+    m_final = UINT64_MAX;
+    m_recoverySeg = 0;
+    m_cwnd = m_initCwnd;
+    m_ssthresh = m_capacity;
+    m_caCount = 0;
+    m_failed = false;
+  }
+
+  void doStop() final
+  {
+    cancelAll();
+  }
+
+  void cancelAll()
+  {
+    for (uint16_t i = 0; i < m_capacity; ++i) {
+      cancel(m_slots[i]);
+    }
+    m_nInFlight = 0;
+    m_nRetx = 0;
+  }
+
+  /** @brief Cancel outstanding Interest or pending retransmission of a slot. */
+  void cancel(Slot& slot)
+  {
+    switch (slot.state) {
+      case SlotState::Pending:
+        m_pit.erase(slot.pit);
+        slot.pit = nullptr;
+        --m_nInFlight;
+        break;
+      case SlotState::Retx:
+        --m_nRetx;
+        break;
+      default:
+        break;
+    }
+    slot.state = SlotState::Idle;
+  }
+
+  void loop() final
+  {
+    if (!m_running) {
+      return;
+    }
+
+    m_pit.processTimeouts();
+    if (m_failed) {
+      fail();
+      return;
+    }
+
+    while (m_nInFlight < m_cwnd) {
+      Slot* slot = nextToSend();
+      if (slot == nullptr) {
+        break;
+      }
+      sendInterest(*slot);
+    }
+  }
+
+  /** @brief Choose a segment to retransmit, or a new segment to request. */
+  Slot* nextToSend()
+  {
+    Slot& head = slotOf(m_segment);
+    if (head.segment == m_segment && head.state == SlotState::Deferred) {
+      return &head;
+    }
+
+    for (uint64_t seg = m_segment; m_nRetx > 0 && seg < m_nextNew; ++seg) {
+      Slot& slot = slotOf(seg);
+      if (slot.state == SlotState::Retx) {
+        --m_nRetx;
+        return &slot;
+      }
+    }
+
+    if (m_nextNew > m_final || m_nextNew >= m_segment + m_capacity) {
+      return nullptr;
+    }
+    Slot& slot = slotOf(m_nextNew);
+    assert(slot.state == SlotState::Idle);
+    slot.segment = m_nextNew++;
+    slot.retxRemain = m_opts.retxLimit;
+    return &slot;
+  }
+
+  void sendInterest(Slot& slot)
+  {
+    m_region.reset();
+    Interest interest = m_region.create<Interest>();
+    assert(!!interest);
+    interest.setName(m_prefix.append<SegmentConvention>(m_region, slot.segment));
+
+    slot.pit = m_pit.insert(interest.getName(), getRetxTimeout(), handleTimeout, &slot);
+    assert(slot.pit != nullptr); // PIT capacity is not less than maximum window
+    slot.state = SlotState::Pending;
+    ++m_nInFlight;
+    send(interest, WithPitToken(slot.pit->getPitToken()));
+  }
+
+  static void handleTimeout(void* arg, PendingInterestTable::Entry&)
+  {
+    Slot& slot = *static_cast<Slot*>(arg);
+    slot.owner->handleTimeout(slot);
+  }
+
+  void handleTimeout(Slot& slot)
+  {
+    slot.pit = nullptr;
+    slot.state = SlotState::Idle;
+    --m_nInFlight;
+    if (scheduleRetx(slot)) {
+      decreaseWindow(slot, true);
+    }
+  }
+
+  /**
+   * @brief Schedule retransmission of a slot that no longer has an outstanding Interest.
+   * @return whether retransmission has been scheduled.
+   */
+  bool scheduleRetx(Slot& slot)
+  {
+    if (slot.segment > m_final) {
+      return false;
+    }
+    if (--slot.retxRemain < 0) {
+      m_failed = true;
+      return false;
+    }
+    slot.state = SlotState::Retx;
+    ++m_nRetx;
+    return true;
+  }
+
+  /**
+   * @brief Halve the window and optionally back off RTO, at most once per window of Interests.
+   *
+   * Losses of Interests sent before the last decrease belong to the same congestion event,
+   * similar to a single retransmission timer expiring once in RFC 6298.
+   */
+  void decreaseWindow(const Slot& slot, bool backoffRto)
+  {
+    if (slot.segment < m_recoverySeg) {
+      return;
+    }
+    if (backoffRto) {
+      m_rtt.backoff();
+    }
+    m_ssthresh = std::max<uint16_t>(m_cwnd / 2, 1);
+    m_cwnd = m_ssthresh;
+    m_caCount = 0;
+    m_recoverySeg = m_nextNew;
+  }
+
+  void increaseWindow()
+  {
+    if (m_cwnd < m_ssthresh) {
+      ++m_cwnd;
+    } else if (++m_caCount >= m_cwnd) {
+      ++m_cwnd;
+      m_caCount = 0;
+    }
+    m_cwnd = std::min(m_cwnd, m_capacity);
+  }
+
+  bool processData(Data data) final
+  {
+    const Name& dataName = data.getName();
+    auto lastComp = dataName[-1];
+    if (!m_running || dataName.size() != m_prefix.size() + 1 || !m_prefix.isPrefixOf(dataName) ||
+        !lastComp.is<SegmentConvention>()) {
+      return false;
+    }
+    uint64_t segment = lastComp.as<SegmentConvention>();
+    if (segment < m_segment || segment >= m_nextNew) {
+      return false;
+    }
+    Slot& slot = slotOf(segment);
+    if (slot.state == SlotState::Received) {
+      return true; // duplicate
+    }
+    if (!data.verify(m_opts.verifier)) {
+      return false;
+    }
+
+    bool wasOutstanding = slot.state == SlotState::Pending;
+    if (wasOutstanding) {
+      // RTT sample is unambiguous if PIT token identifies the latest transmission, or if there
+      // has been no retransmission (Karn's algorithm)
+      const PacketInfo* pi = getCurrentPacketInfo();
+      if ((pi != nullptr && m_pit.find(pi->pitToken) == slot.pit) ||
+          slot.retxRemain == m_opts.retxLimit) {
+        m_rtt.addMeasurement(slot.pit->getSendTime());
+      }
+    }
+    cancel(slot);
+    if (wasOutstanding) {
+      increaseWindow();
+    }
+    if (data.getIsFinalBlock()) {
+      setFinal(segment);
+    }
+
+    if (segment != m_segment) {
+      Encoder encoder(bufOf(slot), m_maxDataLen);
+      if (!encoder.prepend(data)) {
+        slot.state = SlotState::Deferred;
+        return true;
+      }
+      slot.dataOffset = encoder.begin() - bufOf(slot);
+      slot.dataLen = encoder.size();
+      slot.state = SlotState::Received;
+      return true;
+    }
+
+    deliver(data);
+    while (m_running) {
+      Slot& next = slotOf(m_segment);
+      if (next.segment != m_segment || next.state != SlotState::Received) {
+        break;
+      }
+      next.state = SlotState::Idle;
+
+      auto cp = m_region.mark();
+      Data buffered = m_region.create<Data>();
+      bool ok = !!buffered &&
+                Decoder(bufOf(next) + next.dataOffset, next.dataLen).decode(buffered);
+      if (ok) {
+        deliver(buffered);
+      } else {
+        fail();
+      }
+      m_region.restore(cp);
+    }
+    return true;
+  }
+
+  bool processNack(Nack nack) final
+  {
+    const Name& name = nack.getInterest().getName();
+    auto lastComp = name[-1];
+    if (!m_running || name.size() != m_prefix.size() + 1 || !m_prefix.isPrefixOf(name) ||
+        !lastComp.is<SegmentConvention>()) {
+      return false;
+    }
+    uint64_t segment = lastComp.as<SegmentConvention>();
+    if (segment < m_segment || segment >= m_nextNew) {
+      return false;
+    }
+    Slot& slot = slotOf(segment);
+    const PacketInfo* pi = getCurrentPacketInfo();
+    if (slot.state != SlotState::Pending ||
+        (pi != nullptr && pi->pitToken != 0 && m_pit.find(pi->pitToken) != slot.pit)) {
+      return true; // Nack of an earlier transmission
+    }
+
+    cancel(slot);
+    switch (nack.getReason()) {
+      case NackReason::Duplicate: // retransmit with a fresh nonce, without window change
+        scheduleRetx(slot);
+        break;
+      case NackReason::NoRoute: // retransmission would not help
+        m_failed = true;
+        break;
+      case NackReason::Congestion: // the Interest was not lost, so RTO stays
+        if (scheduleRetx(slot)) {
+          decreaseWindow(slot, false);
+        }
+        break;
+      default:
+        if (scheduleRetx(slot)) {
+          decreaseWindow(slot, true);
+        }
+        break;
+    }
+    return true;
+  }
+
+  /** @brief Record final segment number, and cancel Interests beyond it. */
+  void setFinal(uint64_t segment)
+  {
+    m_final = segment;
+    for (uint64_t seg = segment + 1; seg < m_nextNew; ++seg) {
+      cancel(slotOf(seg));
+    }
+    m_nextNew = std::min(m_nextNew, segment + 1);
+  }
+
+  /** @brief Pass in-order Data to the callback. */
+  void deliver(Data data)
+  {
+    invokeCallback(data);
+    if (data.getIsFinalBlock()) {
+      m_running = false;
+      cancelAll();
+    } else {
+      ++m_segment;
+    }
+  }
+
+  void fail()
+  {
+    m_running = false;
+    cancelAll();
+    invokeCallback(Data());
+  }
+
+private:
+  const uint16_t m_capacity;
+  const uint16_t m_initCwnd;
+  const size_t m_maxDataLen;
+  std::unique_ptr<Slot[]> m_slots;
+  std::unique_ptr<uint8_t[]> m_buf;
+  DynamicRegion m_pitRegion;
+  PendingInterestTable m_pit;
+  uint64_t m_nextNew = 0;
+  uint64_t m_final = UINT64_MAX;
+  uint64_t m_recoverySeg = 0;
+  uint16_t m_cwnd = 0;
+  uint16_t m_ssthresh = 0;
+  uint16_t m_caCount = 0;
+  uint16_t m_nInFlight = 0;
+  uint16_t m_nRetx = 0;
+  bool m_failed = false;
+};
+
+using PipelinedSegmentConsumer = BasicPipelinedSegmentConsumer<>;
+
 } // namespace ndnph
 
 #endif // NDNPH_APP_SEGMENT_CONSUMER_HPP
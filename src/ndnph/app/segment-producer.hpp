@@ -30,6 +30,17 @@ public:
      *      omit these two components, achieving a simple form of version discovery.
      */
     int discovery = 2;
+
+    /**
+     * @brief Region for caching signed segments, may be nullptr.
+     *
+     * If specified, each segment is encoded and signed upon its first request, and its wire
+     * encoding is stored in this region. Subsequent requests of the same segment, including
+     * retransmissions and requests from other consumers, are answered without signing.
+     * This region is reset in setContent(), so that it must not be shared. If it runs out of
+     * space, uncached segments are signed upon every request.
+     */
+    Region* cache = nullptr;
   };
 
   /**
@@ -63,6 +74,18 @@ public:
 
     auto d = std::ldiv(size, m_opts.contentLen);
     m_lastSegment = d.quot - static_cast<int>(size > 0 && d.rem == 0);
+
+    m_cached = nullptr;
+    m_cacheFull = false;
+    if (m_opts.cache != nullptr) {
+      m_opts.cache->reset();
+      size_t nSegments = m_lastSegment + 1;
+      m_cached = reinterpret_cast<tlv::Value*>(
+        m_opts.cache->allocA(sizeof(tlv::Value) * nSegments));
+      for (size_t i = 0; m_cached != nullptr && i < nSegments; ++i) {
+        new (&m_cached[i]) tlv::Value();
+      }
+    }
   }
 
 protected:
@@ -72,6 +95,8 @@ protected:
   uint64_t m_lastSegment = 0;
   const uint8_t* m_content = nullptr;
   size_t m_size = 0;
+  tlv::Value* m_cached = nullptr;
+  bool m_cacheFull = false;
 };
 
 /** @brief Producer of segmented object. */
@@ -81,6 +106,22 @@ class BasicSegmentProducer : public SegmentProducerBase
 public:
   using SegmentProducerBase::SegmentProducerBase;
 
+  /**
+   * @brief Encode and sign all segments into the cache now.
+   * @pre Options::cache is specified, and setContent() has been invoked.
+   * @return number of cached segments; less than the number of segments if the cache is full.
+   *
+   * This moves signing cost to before the content is requested.
+   */
+  uint64_t presign()
+  {
+    uint64_t n = 0;
+    for (uint64_t segment = 0; segment <= m_lastSegment && !!getSegment(segment); ++segment) {
+      ++n;
+    }
+    return n;
+  }
+
 private:
   bool processInterest(Interest interest) final
   {
@@ -111,7 +152,20 @@ private:
       return false;
     }
 
+    tlv::Value wire = getSegment(segment);
     m_region.reset();
+    if (!!wire) {
+      reply(m_region, wire);
+      return true;
+    }
+
+    reply(makeSegment(segment).sign(m_opts.signer));
+    return true;
+  }
+
+  /** @brief Create a segment in m_region, without signing. */
+  Data makeSegment(uint64_t segment)
+  {
     Data data = m_region.create<Data>();
     assert(!!data);
     data.setName(m_prefix.append<SegmentConvention>(m_region, segment));
@@ -120,8 +174,37 @@ private:
     data.setContent(
       tlv::Value(m_content + m_opts.contentLen * segment,
                  m_content + std::min<size_t>(m_opts.contentLen * (segment + 1), m_size)));
-    reply(data.sign(m_opts.signer));
-    return true;
+    return data;
+  }
+
+  /**
+   * @brief Retrieve wire encoding of a signed segment from the cache, inserting if necessary.
+   * @return wire encoding, or an empty value if the segment cannot be cached.
+   *
+   * After the cache runs out of space, no further insertion is attempted, so that an uncached
+   * segment is not signed twice per request.
+   */
+  tlv::Value getSegment(uint64_t segment)
+  {
+    if (m_cached == nullptr) {
+      return tlv::Value();
+    }
+    tlv::Value& wire = m_cached[segment];
+    if (!!wire || m_cacheFull) {
+      return wire;
+    }
+
+    m_region.reset();
+    Data data = makeSegment(segment);
+    Encoder encoder(*m_opts.cache);
+    if (!encoder.prepend(data.sign(m_opts.signer))) {
+      encoder.discard();
+      m_cacheFull = true;
+      return tlv::Value();
+    }
+    encoder.trim();
+    wire = tlv::Value(encoder);
+    return wire;
   }
 };
 
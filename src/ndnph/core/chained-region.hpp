@@ -0,0 +1,184 @@
+#ifndef NDNPH_CORE_CHAINED_REGION_HPP
+#define NDNPH_CORE_CHAINED_REGION_HPP
+
+#include "region.hpp"
+
+namespace ndnph {
+
+/**
+ * @brief Pool of fixed-size memory chunks, shared among ChainedRegion instances.
+ *
+ * This class is not thread-safe.
+ */
+class ChunkPool
+{
+public:
+  /**
+   * @brief Constructor.
+   * @param chunkSize capacity of each chunk, which limits the size of an allocation that
+   *                  a ChainedRegion can satisfy from this pool.
+   * @param count number of chunks.
+   */
+  explicit ChunkPool(size_t chunkSize, size_t count)
+    : m_chunkSize(Region::sizeofAligned(chunkSize))
+    , m_array(new uint8_t[sizeofSlot() * count])
+  {
+    for (size_t i = count; i > 0; --i) {
+      give(reinterpret_cast<Chunk*>(&m_array[sizeofSlot() * (i - 1)]));
+    }
+  }
+
+  ChunkPool(const ChunkPool&) = delete;
+  ChunkPool& operator=(const ChunkPool&) = delete;
+
+  /** @brief Return capacity of each chunk. */
+  size_t getChunkSize() const
+  {
+    return m_chunkSize;
+  }
+
+  /** @brief Return number of chunks not in use. */
+  size_t countAvailable() const
+  {
+    return m_nAvail;
+  }
+
+private:
+  struct Chunk
+  {
+    Chunk* next;
+  };
+
+  size_t sizeofSlot() const
+  {
+    return Region::sizeofAligned(sizeof(Chunk)) + m_chunkSize;
+  }
+
+  static uint8_t* payloadOf(Chunk* chunk)
+  {
+    return reinterpret_cast<uint8_t*>(chunk) + Region::sizeofAligned(sizeof(Chunk));
+  }
+
+  Chunk* take()
+  {
+    Chunk* chunk = m_free;
+    if (chunk != nullptr) {
+      m_free = chunk->next;
+      --m_nAvail;
+    }
+    return chunk;
+  }
+
+  void give(Chunk* chunk)
+  {
+    chunk->next = m_free;
+    m_free = chunk;
+    ++m_nAvail;
+  }
+
+private:
+  const size_t m_chunkSize;
+  std::unique_ptr<uint8_t[]> m_array;
+  Chunk* m_free = nullptr;
+  size_t m_nAvail = 0;
+
+  friend class ChainedRegion;
+};
+
+/**
+ * @brief Region that obtains additional chunks from a ChunkPool when exhausted.
+ *
+ * The first chunk is owned by the region. When the current chunk cannot fit an allocation,
+ * another chunk is taken from the pool; remaining space in the previous chunk is not reused
+ * until reset(). reset() returns additional chunks to the pool and keeps the first chunk;
+ * restore() returns chunks obtained after the checkpoint.
+ *
+ * A single allocation must fit in one chunk. available() reports remaining space in the
+ * current chunk, so that an Encoder constructed on this region is limited to that space.
+ * Callers that size a buffer by available() may invoke enlarge() to obtain a pool chunk:
+ * Face::send retries in a pool chunk when the packet does not fit in the current chunk, and
+ * RxQueueMixin places each receive buffer in a pool chunk when it is larger than the first chunk.
+ * Hence, a small first chunk combined with pool chunks sized for jumbo packets can transmit and
+ * receive jumbo packets, as long as the pool is not exhausted.
+ */
+class ChainedRegion : public Region
+{
+public:
+  /**
+   * @brief Constructor.
+   * @param pool where to obtain additional chunks; it must outlive this region.
+   * @param capacity capacity of the first chunk.
+   */
+  explicit ChainedRegion(ChunkPool& pool, size_t capacity)
+    : Region(new uint8_t[capacity], capacity)
+    , m_pool(pool)
+    , m_first(getArray())
+    , m_firstCap(capacity)
+  {
+    static const ChunkOps ops{ next, rewind };
+    setChunkOps(&ops);
+    trackLive();
+  }
+
+  ChainedRegion(const ChainedRegion&) = delete;
+  ChainedRegion& operator=(const ChainedRegion&) = delete;
+
+  ~ChainedRegion()
+  {
+    untrackLive();
+    rewind(*this, nullptr);
+    delete[] m_first;
+  }
+
+  /** @brief Return number of chunks taken from the pool. */
+  size_t countExtraChunks() const
+  {
+    size_t n = 0;
+    for (const ChunkPool::Chunk* chunk = m_extra; chunk != nullptr; chunk = chunk->next) {
+      ++n;
+    }
+    return n;
+  }
+
+private:
+  static bool next(Region& region, size_t size)
+  {
+    auto& self = static_cast<ChainedRegion&>(region);
+    if (size > self.m_pool.getChunkSize()) {
+      return false;
+    }
+    ChunkPool::Chunk* chunk = self.m_pool.take();
+    if (chunk == nullptr) {
+      return false;
+    }
+    chunk->next = self.m_extra;
+    self.m_extra = chunk;
+    self.useChunk(ChunkPool::payloadOf(chunk), self.m_pool.getChunkSize());
+    return true;
+  }
+
+  static void rewind(Region& region, uint8_t* target)
+  {
+    auto& self = static_cast<ChainedRegion&>(region);
+    while (self.m_extra != nullptr && ChunkPool::payloadOf(self.m_extra) != target) {
+      ChunkPool::Chunk* chunk = self.m_extra;
+      self.m_extra = chunk->next;
+      self.m_pool.give(chunk);
+    }
+    if (self.m_extra == nullptr) {
+      self.useChunk(self.m_first, self.m_firstCap);
+    } else {
+      self.useChunk(target, self.m_pool.getChunkSize());
+    }
+  }
+
+private:
+  ChunkPool& m_pool;
+  uint8_t* m_first;
+  size_t m_firstCap;
+  ChunkPool::Chunk* m_extra = nullptr;
+};
+
+} // namespace ndnph
+
+#endif // NDNPH_CORE_CHAINED_REGION_HPP
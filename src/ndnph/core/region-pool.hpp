@@ -0,0 +1,224 @@
+#ifndef NDNPH_CORE_REGION_POOL_HPP
+#define NDNPH_CORE_REGION_POOL_HPP
+
+#include "region.hpp"
+
+#include <atomic>
+
+namespace ndnph {
+
+/**
+ * @brief Pool of fixed-size Regions carved from one slab.
+ *
+ * acquire() and release() are lock-free and may be invoked from different threads, so that
+ * a Region filled by one thread can be handed to another thread and released there.
+ * The free list is a stack whose head carries a generation tag to prevent ABA problem.
+ */
+class RegionPool
+{
+public:
+  class Handle;
+
+  /**
+   * @brief Constructor.
+   * @param capacity capacity of each Region.
+   * @param count number of Regions, less than 65535.
+   */
+  explicit RegionPool(size_t capacity, uint16_t count)
+    : m_slab(sizeofSubRegions(capacity, count))
+    , m_next(new std::atomic<uint16_t>[count])
+    , m_count(count)
+  {
+    assert(count < NONE);
+    for (uint16_t i = 0; i < count; ++i) {
+      Region* region = makeSubRegion(m_slab, capacity);
+      assert(region != nullptr);
+      if (i == 0) {
+        m_first = reinterpret_cast<uint8_t*>(region);
+      } else if (i == 1) {
+        m_stride = reinterpret_cast<uint8_t*>(region) - m_first;
+      }
+      m_next[i].store(i + 1 == count ? NONE : i + 1, std::memory_order_relaxed);
+    }
+    m_head.store(count == 0 ? NONE : 0, std::memory_order_release);
+  }
+
+  RegionPool(const RegionPool&) = delete;
+  RegionPool& operator=(const RegionPool&) = delete;
+
+  /** @brief Return number of Regions in the pool. */
+  uint16_t size() const
+  {
+    return m_count;
+  }
+
+  /**
+   * @brief Take a Region from the pool.
+   * @return a handle that releases the Region when destructed; empty if pool is exhausted.
+   * @post the Region has been reset.
+   */
+  Handle acquire();
+
+  /**
+   * @brief Return a Region to the pool.
+   * @param region a Region previously detached from a Handle of this pool.
+   */
+  void release(Region* region)
+  {
+    uint16_t index = indexOf(region);
+    uint32_t head = m_head.load(std::memory_order_relaxed);
+    uint32_t newHead = 0;
+    do {
+      m_next[index].store(head & NONE, std::memory_order_relaxed);
+      newHead = nextTag(head) | index;
+    } while (!m_head.compare_exchange_weak(head, newHead, std::memory_order_release,
+                                           std::memory_order_relaxed));
+  }
+
+private:
+  enum : uint16_t
+  {
+    NONE = 0xFFFF,
+  };
+
+  static uint32_t nextTag(uint32_t head)
+  {
+    return (head & 0xFFFF0000) + 0x00010000;
+  }
+
+  Region* regionAt(uint16_t index)
+  {
+    return reinterpret_cast<Region*>(m_first + m_stride * index);
+  }
+
+  uint16_t indexOf(Region* region) const
+  {
+    size_t offset = reinterpret_cast<uint8_t*>(region) - m_first;
+    assert(m_stride == 0 ? offset == 0 : offset % m_stride == 0);
+    uint16_t index = m_stride == 0 ? 0 : offset / m_stride;
+    assert(index < m_count);
+    return index;
+  }
+
+  Region* pop()
+  {
+    uint32_t head = m_head.load(std::memory_order_acquire);
+    uint16_t index = NONE;
+    do {
+      index = head & NONE;
+      if (index == NONE) {
+        return nullptr;
+      }
+      uint32_t newHead = nextTag(head) | m_next[index].load(std::memory_order_relaxed);
+      if (m_head.compare_exchange_weak(head, newHead, std::memory_order_acquire,
+                                       std::memory_order_acquire)) {
+        break;
+      }
+    } while (true);
+    return regionAt(index);
+  }
+
+private:
+  DynamicRegion m_slab;
+  std::unique_ptr<std::atomic<uint16_t>[]> m_next;
+  std::atomic<uint32_t> m_head{ NONE };
+  uint8_t* m_first = nullptr;
+  size_t m_stride = 0;
+  uint16_t m_count = 0;
+};
+
+/** @brief Exclusive ownership of a Region acquired from RegionPool. */
+class RegionPool::Handle
+{
+public:
+  Handle() = default;
+
+  Handle(Handle&& other) noexcept
+    : m_pool(other.m_pool)
+    , m_region(other.detach())
+  {}
+
+  Handle& operator=(Handle&& other) noexcept
+  {
+    if (this != &other) {
+      reset();
+      m_pool = other.m_pool;
+      m_region = other.detach();
+    }
+    return *this;
+  }
+
+  ~Handle()
+  {
+    reset();
+  }
+
+  explicit operator bool() const
+  {
+    return m_region != nullptr;
+  }
+
+  Region& operator*() const
+  {
+    return *m_region;
+  }
+
+  Region* operator->() const
+  {
+    return m_region;
+  }
+
+  Region* get() const
+  {
+    return m_region;
+  }
+
+  /** @brief Return the Region to the pool. */
+  void reset()
+  {
+    if (m_region != nullptr) {
+      m_pool->release(m_region);
+      m_region = nullptr;
+    }
+  }
+
+  /**
+   * @brief Give up ownership without returning the Region to the pool.
+   *
+   * This allows passing the Region through a queue to another thread, which should
+   * eventually invoke RegionPool::release().
+   */
+  Region* detach()
+  {
+    Region* region = m_region;
+    m_region = nullptr;
+    return region;
+  }
+
+private:
+  explicit Handle(RegionPool* pool, Region* region)
+    : m_pool(pool)
+    , m_region(region)
+  {}
+
+private:
+  RegionPool* m_pool = nullptr;
+  Region* m_region = nullptr;
+
+  friend RegionPool;
+};
+
+inline RegionPool::Handle
+RegionPool::acquire()
+{
+  Region* region = pop();
+  if (region == nullptr) {
+    return Handle();
+  }
+  region->reset();
+  return Handle(this, region);
+}
+
+} // namespace ndnph
+
+#endif // NDNPH_CORE_REGION_POOL_HPP
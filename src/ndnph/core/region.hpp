@@ -2,9 +2,31 @@
 #define NDNPH_CORE_REGION_HPP
 
 #include "common.hpp"
+#ifdef NDNPH_REGION_STATS
+#include "printing.hpp"
+#include <atomic>
+#endif
 
 namespace ndnph {
 
+#ifdef NDNPH_REGION_STATS
+/**
+ * @brief Region usage statistics.
+ *
+ * This is collected only if NDNPH_REGION_STATS is defined.
+ */
+struct RegionStats
+{
+  const char* name = nullptr;           ///< label assigned via Region::setStatsName
+  size_t capacity = 0;                  ///< total capacity
+  size_t peak = 0;                      ///< maximum utilized space since last resetStats()
+  uint32_t nAllocs = 0;                 ///< count of successful alloc() and allocA()
+  uint32_t nFailures = 0;               ///< count of failed alloc() and allocA()
+  size_t lastFailureSize = 0;           ///< requested size of last failed allocation
+  const char* lastFailureTag = nullptr; ///< caller tag active during last failed allocation
+};
+#endif // NDNPH_REGION_STATS
+
 /** @brief Region-based memory allocator thats owns memory of NDNph objects. */
 class Region
 {
@@ -30,11 +52,11 @@ public:
   /** @brief Allocate a buffer with no alignment requirement. */
   uint8_t* alloc(size_t size)
   {
-    if (available() < size) {
-      return nullptr;
+    if (available() < size && !nextChunk(size)) {
+      return recordAlloc(nullptr, size);
     }
     m_right -= size;
-    return m_right;
+    return recordAlloc(m_right, size);
   }
 
   /** @brief Allocate a region aligned to multiple of sizeof(void*). */
@@ -42,10 +64,13 @@ public:
   {
     uint8_t* room = alignUp(m_left);
     if (m_right - room < static_cast<ssize_t>(size)) {
-      return nullptr;
+      if (!nextChunk(size)) {
+        return recordAlloc(nullptr, size);
+      }
+      room = alignUp(m_left);
     }
     m_left = room + size;
-    return room;
+    return recordAlloc(room, size);
   }
 
   /**
@@ -109,16 +134,73 @@ public:
    */
   void reset()
   {
+    if (m_chunkOps != nullptr) {
+      m_chunkOps->rewind(*this, nullptr);
+    }
     m_left = m_begin;
     m_right = m_end;
   }
 
-  /** @brief Compute remaining space for alloc(). */
+  /** @brief Saved allocation state. */
+  class Checkpoint
+  {
+  private:
+    uint8_t* m_begin = nullptr;
+    uint8_t* m_left = nullptr;
+    uint8_t* m_right = nullptr;
+
+    friend Region;
+  };
+
+  /** @brief Save current allocation state. */
+  Checkpoint mark() const
+  {
+    Checkpoint cp;
+    cp.m_begin = m_begin;
+    cp.m_left = m_left;
+    cp.m_right = m_right;
+    return cp;
+  }
+
+  /**
+   * @brief Discard items allocated after a checkpoint.
+   * @pre @p cp was saved from this region, and the region has not been reset or restored to
+   *      an earlier checkpoint since then.
+   * @post Items allocated after @p cp are invalidated.
+   */
+  void restore(const Checkpoint& cp)
+  {
+    if (cp.m_begin != m_begin) {
+      assert(m_chunkOps != nullptr);
+      m_chunkOps->rewind(*this, cp.m_begin);
+    }
+    m_left = cp.m_left;
+    m_right = cp.m_right;
+  }
+
+  /**
+   * @brief Compute remaining space for alloc().
+   *
+   * In a region that spans multiple chunks, this only counts the current chunk.
+   * @sa enlarge()
+   */
   size_t available() const
   {
     return m_right - m_left;
   }
 
+  /**
+   * @brief Switch to an empty chunk if it would have more room than the current chunk.
+   * @return whether available() has increased.
+   *
+   * This has no effect unless the region spans multiple chunks. It allows a caller that sizes
+   * a buffer by available(), such as Encoder, to obtain a whole chunk.
+   */
+  bool enlarge()
+  {
+    return nextChunk(available() + 1);
+  }
+
   /** @brief Compute remaining space for allocA(). */
   size_t availableA() const
   {
@@ -131,13 +213,201 @@ public:
     return m_end - m_begin - available();
   }
 
+#ifdef NDNPH_REGION_STATS
+  /** @brief Assign a label to appear in statistics report. */
+  void setStatsName(const char* name)
+  {
+    m_stats.name = name;
+  }
+
+  /** @brief Retrieve usage statistics. */
+  RegionStats getStats() const
+  {
+    RegionStats stats = m_stats;
+    stats.capacity = m_end - m_begin;
+    return stats;
+  }
+
+  /** @brief Clear usage statistics, except name. */
+  void resetStats()
+  {
+    const char* name = m_stats.name;
+    m_stats = RegionStats();
+    m_stats.name = name;
+    m_stats.peak = size();
+  }
+
+  /**
+   * @brief Attach a caller tag to allocation failures within a scope.
+   * @sa NDNPH_REGION_TAG
+   */
+  class ScopedStatsTag
+  {
+  public:
+    explicit ScopedStatsTag(Region& region, const char* tag)
+      : m_region(region)
+      , m_prev(region.m_tag)
+    {
+      region.m_tag = tag;
+    }
+
+    ~ScopedStatsTag()
+    {
+      m_region.m_tag = m_prev;
+    }
+
+  private:
+    Region& m_region;
+    const char* m_prev;
+  };
+
+  /**
+   * @brief Iterate over statistics of live regions.
+   * @tparam F `void (*)(const RegionStats&)`
+   *
+   * Live regions include every StaticRegion and DynamicRegion that has not been destructed.
+   * Sub regions created by makeSubRegion() are not tracked.
+   * Regions may be constructed and destructed concurrently in other threads, but @p f must
+   * not construct or destruct a tracked region. Statistics of a region that is being used in
+   * another thread may be inconsistent.
+   */
+  template<typename F>
+  static void forEachLive(const F& f)
+  {
+    LiveLock lock;
+    for (const Region* r = liveHead(); r != nullptr; r = r->m_nextLive) {
+      f(r->getStats());
+    }
+  }
+#endif // NDNPH_REGION_STATS
+
 protected:
   uint8_t* getArray()
   {
     return m_begin;
   }
 
+  /** @brief Hooks of a region that spans multiple chunks. */
+  struct ChunkOps
+  {
+    /**
+     * @brief Switch to another chunk when current chunk cannot fit an allocation.
+     * @return whether useChunk() has been invoked with a chunk that can fit @p size octets
+     *         at an aligned address.
+     */
+    bool (*next)(Region& self, size_t size);
+
+    /**
+     * @brief Release chunks obtained by @c next after the specified chunk, and switch to it.
+     * @param chunk starting address of a chunk, or nullptr to indicate the first chunk.
+     */
+    void (*rewind)(Region& self, uint8_t* chunk);
+  };
+
+  void setChunkOps(const ChunkOps* ops)
+  {
+    m_chunkOps = ops;
+  }
+
+  /**
+   * @brief Make subsequent allocations from the given chunk.
+   * @post Allocated items in the previous chunk remain valid until reset().
+   */
+  void useChunk(uint8_t* buf, size_t cap)
+  {
+    m_begin = buf;
+    m_end = buf + cap;
+    m_left = m_begin;
+    m_right = m_end;
+  }
+
+#ifdef NDNPH_REGION_STATS
+  void trackLive()
+  {
+    LiveLock lock;
+    Region*& head = liveHead();
+    m_nextLive = head;
+    m_prevLive = &head;
+    if (head != nullptr) {
+      head->m_prevLive = &m_nextLive;
+    }
+    head = this;
+  }
+
+  void untrackLive()
+  {
+    LiveLock lock;
+    *m_prevLive = m_nextLive;
+    if (m_nextLive != nullptr) {
+      m_nextLive->m_prevLive = m_prevLive;
+    }
+  }
+#else
+  void trackLive() {}
+
+  void untrackLive() {}
+#endif // NDNPH_REGION_STATS
+
 private:
+  bool nextChunk(size_t size)
+  {
+    return m_chunkOps != nullptr && m_chunkOps->next(*this, size);
+  }
+
+#ifdef NDNPH_REGION_STATS
+  static Region*& liveHead()
+  {
+    static Region* head = nullptr;
+    return head;
+  }
+
+  /**
+   * @brief Spinlock protecting the live regions list.
+   *
+   * Regions may be constructed and destructed in multiple threads, such as the shard threads
+   * of UdpShardedListener. Critical sections are a few pointer assignments.
+   */
+  class LiveLock
+  {
+  public:
+    LiveLock()
+    {
+      while (flag().test_and_set(std::memory_order_acquire)) {
+      }
+    }
+
+    ~LiveLock()
+    {
+      flag().clear(std::memory_order_release);
+    }
+
+  private:
+    static std::atomic_flag& flag()
+    {
+      static std::atomic_flag f = ATOMIC_FLAG_INIT;
+      return f;
+    }
+  };
+
+  uint8_t* recordAlloc(uint8_t* room, size_t size)
+  {
+    if (room == nullptr) {
+      ++m_stats.nFailures;
+      m_stats.lastFailureSize = size;
+      m_stats.lastFailureTag = m_tag;
+    } else {
+      ++m_stats.nAllocs;
+      m_stats.peak = std::max(m_stats.peak, this->size());
+    }
+    return room;
+  }
+#else
+  static uint8_t* recordAlloc(uint8_t* room, size_t)
+  {
+    return room;
+  }
+#endif // NDNPH_REGION_STATS
+
   static uint8_t* alignUp(uint8_t* ptr)
   {
     return reinterpret_cast<uint8_t*>(
@@ -145,12 +415,80 @@ private:
   }
 
 private:
-  uint8_t* const m_begin;
-  uint8_t* const m_end;
+  uint8_t* m_begin;
+  uint8_t* m_end;
   uint8_t* m_left;  ///< [m_begin, m_left) is allocated for aligned items
   uint8_t* m_right; ///< [m_right, m_end) is allocated for unaligned items
+  const ChunkOps* m_chunkOps = nullptr;
+#ifdef NDNPH_REGION_STATS
+  RegionStats m_stats;
+  const char* m_tag = nullptr;
+  Region* m_nextLive = nullptr;
+  Region** m_prevLive = nullptr; ///< address of the pointer that points to this region
+#endif // NDNPH_REGION_STATS
 };
 
+#ifdef NDNPH_REGION_STATS
+/**
+ * @brief Attach a caller tag to allocation failures in a region until end of current scope.
+ *
+ * This has no effect if NDNPH_REGION_STATS is not defined.
+ */
+#define NDNPH_REGION_TAG(region, tag)                                                              \
+  ::ndnph::Region::ScopedStatsTag NDNPH_REGION_TAG_VAR(__LINE__)(region, tag)
+#define NDNPH_REGION_TAG_VAR(line) NDNPH_REGION_TAG_VAR_(line)
+#define NDNPH_REGION_TAG_VAR_(line) ndnphRegionTag##line
+
+namespace detail {
+
+template<typename F>
+void
+printRegionStats(const RegionStats& stats, const F& output)
+{
+  char buf[160];
+  snprintf(buf, sizeof(buf), "%s capacity=%lu peak=%lu allocs=%lu failures=%lu",
+           stats.name == nullptr ? "(unnamed)" : stats.name,
+           static_cast<unsigned long>(stats.capacity), static_cast<unsigned long>(stats.peak),
+           static_cast<unsigned long>(stats.nAllocs), static_cast<unsigned long>(stats.nFailures));
+  output(buf);
+  if (stats.nFailures > 0) {
+    snprintf(buf, sizeof(buf), " last-failure=%lu@%s",
+             static_cast<unsigned long>(stats.lastFailureSize),
+             stats.lastFailureTag == nullptr ? "(untagged)" : stats.lastFailureTag);
+    output(buf);
+  }
+  output("\n");
+}
+
+} // namespace detail
+
+#ifdef NDNPH_PRINT_ARDUINO
+/** @brief Print statistics of all live regions, one per line. */
+inline void
+dumpRegionStats(::Print& p)
+{
+  Region::forEachLive([&p](const RegionStats& stats) {
+    detail::printRegionStats(stats, [&p](const char* str) { p.print(str); });
+  });
+}
+#endif
+
+#ifdef NDNPH_PRINT_OSTREAM
+/** @brief Print statistics of all live regions, one per line. */
+inline void
+dumpRegionStats(std::ostream& os)
+{
+  Region::forEachLive([&os](const RegionStats& stats) {
+    detail::printRegionStats(stats, [&os](const char* str) { os << str; });
+  });
+}
+#endif
+#else
+#define NDNPH_REGION_TAG(region, tag)                                                              \
+  do {                                                                                             \
+  } while (false)
+#endif // NDNPH_REGION_STATS
+
 /**
  * @brief Region with statically allocated memory.
  * @tparam C capacity.
@@ -161,9 +499,18 @@ class StaticRegion : public Region
 public:
   StaticRegion()
     : Region(m_array, sizeof(m_array))
-  {}
+  {
+    trackLive();
+  }
 
+#ifdef NDNPH_REGION_STATS
+  ~StaticRegion()
+  {
+    untrackLive();
+  }
+#else
   ~StaticRegion() = default;
+#endif
 
 private:
   uint8_t m_array[C];
@@ -175,10 +522,13 @@ class DynamicRegion : public Region
 public:
   DynamicRegion(size_t capacity)
     : Region(new uint8_t[capacity], capacity)
-  {}
+  {
+    trackLive();
+  }
 
   ~DynamicRegion()
   {
+    untrackLive();
     delete[] getArray();
   }
 };
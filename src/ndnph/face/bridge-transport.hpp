@@ -2,6 +2,7 @@
 #define NDNPH_FACE_BRIDGE_TRANSPORT_HPP
 
 #include "transport-rxqueue.hpp"
+#include "transport-txqueue.hpp"
 
 namespace ndnph {
 
@@ -9,9 +10,12 @@ namespace ndnph {
 class BridgeTransport
   : public virtual Transport
   , public transport::DynamicRxQueueMixin
+  , public transport::TxQueueMixin
 {
 public:
-  using transport::DynamicRxQueueMixin::DynamicRxQueueMixin;
+  explicit BridgeTransport(size_t bufLen = DEFAULT_BUFLEN, size_t rxRoom = 0)
+    : DynamicRxQueueMixin(bufLen, rxRoom)
+  {}
 
   /**
    * @brief Connect to peer transport.
@@ -54,6 +58,14 @@ private:
     if (m_peer == nullptr) {
       return false;
     }
+    if (enqueueTx(pkt, pktLen, endpointId)) {
+      return true;
+    }
+    return sendToPeer(pkt, pktLen, endpointId);
+  }
+
+  bool sendToPeer(const uint8_t* pkt, size_t pktLen, uint64_t endpointId)
+  {
     if (auto r = m_peer->receiving()) {
       if (r.bufLen() < pktLen) {
         return false;
@@ -65,6 +77,43 @@ private:
     return false;
   }
 
+  bool doCanSendv() const final
+  {
+    return true;
+  }
+
+  bool doSendv(const tlv::Value* segs, size_t count, uint64_t endpointId) final
+  {
+    if (m_peer == nullptr) {
+      return false;
+    }
+    if (enqueueTx(segs, count, endpointId)) {
+      return true;
+    }
+    if (auto r = m_peer->receiving()) {
+      size_t pktLen = 0;
+      for (size_t i = 0; i < count; ++i) {
+        if (r.bufLen() - pktLen < segs[i].size()) {
+          return false;
+        }
+        std::copy(segs[i].begin(), segs[i].end(), r.buf() + pktLen);
+        pktLen += segs[i].size();
+      }
+      r(pktLen, endpointId);
+      return true;
+    }
+    return false;
+  }
+
+  size_t doSendBurst(const transport::TxPacket* pkts, size_t count) final
+  {
+    size_t nSent = 0;
+    for (size_t i = 0; i < count && m_peer != nullptr; ++i) {
+      nSent += static_cast<int>(sendToPeer(pkts[i].pkt, pkts[i].pktLen, pkts[i].endpointId));
+    }
+    return nSent;
+  }
+
 private:
   BridgeTransport* m_peer = nullptr;
 };
@@ -2,8 +2,18 @@
 #define NDNPH_FACE_FACE_HPP
 
 #include "../packet/lp.hpp"
+#include "../packet/name-hash.hpp"
 #include "transport.hpp"
 
+#ifndef NDNPH_FACE_PREFIX_MAXCOMPS
+/**
+ * @brief Maximum number of components in a prefix registered with Face::addPrefix().
+ *
+ * Interest dispatch keeps this many prefix hashes on the stack.
+ */
+#define NDNPH_FACE_PREFIX_MAXCOMPS 16
+#endif
+
 namespace ndnph {
 
 class PacketHandler;
@@ -34,6 +44,7 @@ public:
     , m_transport(transport)
   {
     m_transport.setRxCallback(transportRx, this);
+    m_transport.setRxBurstCallback(transportRxBurst, this);
   }
 
   explicit Face(Transport& transport)
@@ -72,19 +83,73 @@ public:
     m_reass = &reass;
   }
 
+  /**
+   * @brief Enable or disable decoding incoming packets in place.
+   *
+   * If enabled and supported by the transport, packet objects (e.g. @c DataObj ) are allocated
+   * in the remaining space of the Region that contains the packet buffer, instead of the face
+   * region. This allows a PacketHandler to retain the packet via retainCurrentPacket() without
+   * copying. If the packet buffer lacks space, the face region is used as usual.
+   */
+  void setRxInPlace(bool enable)
+  {
+    m_rxInPlace = enable;
+  }
+
+  /**
+   * @brief Enable or disable lazy decoding of incoming Data packets.
+   *
+   * If enabled, incoming Data packets are passed to packet handlers with only Name decoded.
+   * Other fields are decoded when a handler first accesses them.
+   * @sa Data::setLazyDecode
+   */
+  void setLazyDecode(bool enable)
+  {
+    m_lazyDecode = enable;
+  }
+
   /**
    * @brief Add a packet handler.
    * @param prio priority, smaller number means higher priority.
    */
   bool addHandler(PacketHandler& h, int8_t prio = 0);
 
-  /** @brief Remove a packet handler. */
+  /** @brief Remove a packet handler, along with its registered prefixes. */
   bool removeHandler(PacketHandler& h);
 
+  /**
+   * @brief Enable prefix-indexed Interest dispatch.
+   * @param region where to allocate the index. It must be kept until face is destructed.
+   * @param capacity maximum number of prefix registrations.
+   * @return whether success.
+   *
+   * When enabled, a packet handler may register name prefixes with addPrefix(). An incoming
+   * Interest is offered to handlers registered on prefixes of its name, longest prefix first and
+   * in priority order among handlers of the same prefix, and then to handlers without registered
+   * prefixes in priority order. Data and Nack packets are offered to all handlers as usual.
+   */
+  bool enablePrefixIndex(Region& region, size_t capacity);
+
+  /**
+   * @brief Register a name prefix for a packet handler.
+   * @param h packet handler added to this face.
+   * @param prefix name prefix with at most NDNPH_FACE_PREFIX_MAXCOMPS components. Its TLV-VALUE
+   *               must remain valid until the prefix or the handler is removed.
+   * @return whether success. If the prefix index is disabled or full, returns false and the
+   *         handler continues to receive every Interest that other handlers do not accept.
+   *
+   * Once a handler has a registered prefix, it only receives Interests under its prefixes.
+   */
+  bool addPrefix(PacketHandler& h, const Name& prefix);
+
+  /** @brief Unregister a name prefix for a packet handler. */
+  bool removePrefix(PacketHandler& h, const Name& prefix);
+
   /**
    * @brief Process periodical events.
    *
    * This must be invoked periodically.
+   * At the end, packets deferred by transport TX batching are transmitted.
    */
   void loop();
 
@@ -93,8 +158,21 @@ public:
     return m_currentPacketInfo;
   }
 
+  /**
+   * @brief Retain current processing packet after its processing function returns.
+   * @return a handle that keeps the packet and its objects valid; empty handle if the packet
+   *         was not decoded in place.
+   * @sa setRxInPlace
+   */
+  transport::RxBufferRef retainCurrentPacket()
+  {
+    return m_rxRegion == nullptr ? transport::RxBufferRef() : m_transport.retainRx();
+  }
+
   /**
    * @brief Synchronously transmit a packet.
+   *
+   * If the transport has TX batching enabled, the packet may be deferred until the end of loop().
    * @sa PacketHandler::send
    */
   template<typename Packet>
@@ -119,6 +197,13 @@ private:
     Face& m_face;
   };
 
+  /**
+   * @brief Encode a packet without fragmentation and transmit it.
+   * @param[out] encoded whether encoding succeeded.
+   */
+  template<typename Encodable>
+  bool encodeAndSend(Region& region, const Encodable& lpp, uint64_t endpointId, bool& encoded);
+
   static void transportRx(void* self, const uint8_t* pkt, size_t pktLen, uint64_t endpointId)
   {
     reinterpret_cast<Face*>(self)->transportRx(pkt, pktLen, endpointId);
@@ -126,9 +211,55 @@ private:
 
   void transportRx(const uint8_t* pkt, size_t pktLen, uint64_t endpointId);
 
+  static void transportRxBurst(void* self, const transport::RxPacket* pkts, size_t count)
+  {
+    reinterpret_cast<Face*>(self)->transportRxBurst(pkts, count);
+  }
+
+  void transportRxBurst(const transport::RxPacket* pkts, size_t count);
+
+  /** @brief Classify, decode, and dispatch a packet, using the face region as is. */
+  void processRx(const uint8_t* pkt, size_t pktLen, uint64_t endpointId);
+
+  template<typename Packet, typename H = bool (PacketHandler::*)(Packet)>
+  void decodeAndProcess(const lp::PacketClassify& classify,
+                        bool (lp::PacketClassify::*decode)(Packet) const, H processPacket);
+
   template<typename Packet, typename H = bool (PacketHandler::*)(Packet)>
   bool process(H processPacket, Packet packet);
 
+  template<typename Packet, typename H>
+  bool processByPrefix(H, Packet)
+  {
+    return false;
+  }
+
+  template<typename H>
+  bool processByPrefix(H processPacket, Interest interest);
+
+  struct PrefixReg
+  {
+    Name prefix;
+    uint64_t hash = 0;
+    PacketHandler* handler = nullptr;
+    PrefixReg* next = nullptr;
+  };
+  using PrefixIndex = NameHashMap<PrefixReg*>;
+
+  /** @brief Unlink a registration from the index and return it to the free list. */
+  void removePrefixReg(PrefixReg* reg);
+
+  template<typename Packet>
+  void prepareDecode(Packet&)
+  {}
+
+  void prepareDecode(Data& data)
+  {
+    if (data) {
+      data.setLazyDecode(m_lazyDecode);
+    }
+  }
+
 private:
   using OwnRegion = StaticRegion<2048>;
   std::unique_ptr<OwnRegion> m_ownRegion;
@@ -136,7 +267,14 @@ private:
   lp::Fragmenter* m_frag = nullptr;
   lp::Reassembler* m_reass = nullptr;
   PacketHandler* m_handler = nullptr;
+  PrefixIndex* m_prefixIndex = nullptr;
+  PrefixReg* m_prefixRegs = nullptr;
+  PrefixReg* m_prefixFree = nullptr;
+  size_t m_nPrefixRegs = 0;
   const PacketInfo* m_currentPacketInfo = nullptr;
+  Region* m_rxRegion = nullptr;
+  bool m_rxInPlace = false;
+  bool m_lazyDecode = false;
 };
 
 } // namespace ndnph
@@ -44,6 +44,18 @@ protected:
     return m_face == nullptr ? nullptr : m_face->getCurrentPacketInfo();
   }
 
+  /**
+   * @brief Retain current processing packet after its processing function returns.
+   * @pre one of processInterest, processData, or processNack is executing.
+   * @return a handle that keeps the packet and its objects valid; empty handle if unsupported.
+   *         The handle must be released on the thread that invokes Face::loop().
+   * @sa Face::setRxInPlace
+   */
+  transport::RxBufferRef retainCurrentPacket() const
+  {
+    return m_face == nullptr ? transport::RxBufferRef() : m_face->retainCurrentPacket();
+  }
+
   /**
    * @brief Synchronously transmit a packet.
    * @tparam Packet Interest, Data, their signed variants, or Nack.
@@ -157,7 +169,8 @@ protected:
     template<typename Packet, typename... Arg>
     bool send(const Packet& interest, int timeout, Arg&&... arg)
     {
-      m_expire = ndnph::port::Clock::add(ndnph::port::Clock::now(), timeout);
+      m_sendTime = ndnph::port::Clock::now();
+      m_expire = ndnph::port::Clock::add(m_sendTime, timeout);
       return m_ph.send(interest, WithPitToken(++m_pitToken), std::forward<Arg>(arg)...);
     }
 
@@ -206,17 +219,26 @@ protected:
      * @param data incoming Data.
      * @param name saved outgoing Interest name.
      * @param canBePrefix CanBePrefix flag on the Interest.
+     * @return whether @p data matches. This is false if the region of @p data cannot fit a
+     *         temporary Interest; when receiving in place, reserve it via transport rxRoom.
      */
     bool match(const Data& data, const Name& name, bool canBePrefix = true) const
     {
-      StaticRegion<512> region;
+      // Lazily decoded fields must be allocated before the checkpoint, so that they survive
+      // the rollback.
+      data.finishDecode();
+
+      Region& region = regionOf(data);
+      auto cp = region.mark();
       auto interest = region.create<Interest>();
-      if (!interest) {
-        return false;
+      bool ok = false;
+      if (interest) {
+        interest.setName(name);
+        interest.setCanBePrefix(canBePrefix);
+        ok = match(data, interest);
       }
-      interest.setName(name);
-      interest.setCanBePrefix(canBePrefix);
-      return match(data, interest);
+      region.restore(cp);
+      return ok;
     }
 
     /** @brief Determine if the pending Interest has expired / timed out. */
@@ -225,9 +247,21 @@ protected:
       return ndnph::port::Clock::isBefore(m_expire, ndnph::port::Clock::now());
     }
 
+    /**
+     * @brief Return the time when the last outgoing Interest was sent.
+     *
+     * Since each outgoing Interest carries a distinct PIT token, an incoming packet accepted by
+     * matchPitToken() yields an unambiguous RTT sample relative to this time.
+     */
+    port::Clock::Time getSendTime() const
+    {
+      return m_sendTime;
+    }
+
   private:
     PacketHandler& m_ph;
     uint64_t m_pitToken = 0;
+    port::Clock::Time m_sendTime;
     port::Clock::Time m_expire;
   };
 
@@ -276,6 +310,7 @@ private:
 private:
   Face* m_face = nullptr;
   PacketHandler* m_next = nullptr;
+  uint16_t m_nPrefixes = 0;
   int8_t m_prio = 0;
   friend Face;
 };
@@ -0,0 +1,388 @@
+#ifndef NDNPH_FACE_PENDING_INTEREST_TABLE_HPP
+#define NDNPH_FACE_PENDING_INTEREST_TABLE_HPP
+
+#include "../packet/data.hpp"
+#include "../packet/nack.hpp"
+#include "../packet/name-hash.hpp"
+#include "../port/clock/port.hpp"
+#include "../port/random/port.hpp"
+
+#ifndef NDNPH_PIT_MAXCOMPS
+/**
+ * @brief Maximum Data name components considered in PendingInterestTable name match fallback.
+ *
+ * Name match fallback keeps this many prefix hashes on the stack.
+ */
+#define NDNPH_PIT_MAXCOMPS 16
+#endif
+
+namespace ndnph {
+
+/**
+ * @brief Table of outgoing pending Interests, keyed by PIT token.
+ *
+ * Each entry is assigned a PIT token that encodes its slot index and a generation number, so
+ * that an incoming Data or Nack carrying the PIT token is matched to its entry in constant time.
+ * If the table is constructed with name storage, an entry can also be found by Interest name,
+ * which serves as a fallback when the PIT token was not returned by the forwarder. If several
+ * entries have the same name, lookup by name finds the newest one.
+ *
+ * Entries are kept in expiration order. processTimeouts() invokes the timeout callback of each
+ * expired entry and then erases it.
+ *
+ * @code
+ * auto entry = pit.insert(interest.getName(), interest.getLifetime(), onTimeout, this);
+ * if (entry != nullptr) {
+ *   send(interest, WithPitToken(entry->getPitToken()));
+ * }
+ * // in processData
+ * auto entry = pit.findData(getCurrentPacketInfo()->pitToken, data);
+ * @endcode
+ */
+class PendingInterestTable
+{
+private:
+  enum : uint32_t
+  {
+    NONE = 0xFFFFFFFF,
+  };
+
+  static constexpr uint64_t TagMask = 0xFFFF000000000000;
+
+public:
+  class Entry;
+
+  /**
+   * @brief Callback when an entry expires.
+   * @param arg argument given to insert().
+   * @param entry the expired entry; it is erased after the callback returns.
+   */
+  using TimeoutCallback = void (*)(void* arg, Entry& entry);
+
+  /** @brief Pending Interest record. */
+  class Entry
+  {
+  public:
+    /** @brief Return PIT token to be attached to the outgoing Interest. */
+    uint64_t getPitToken() const
+    {
+      return m_token;
+    }
+
+    /**
+     * @brief Return Interest name.
+     * @return a copy in the table, or an invalid Name if the table has no name storage.
+     */
+    const Name& getName() const
+    {
+      return m_name;
+    }
+
+    /** @brief Return the time when the entry was inserted. */
+    port::Clock::Time getSendTime() const
+    {
+      return m_sendTime;
+    }
+
+    /** @brief Return the time when the entry expires. */
+    port::Clock::Time getExpiry() const
+    {
+      return m_expiry;
+    }
+
+    /** @brief Return argument given to insert(). */
+    void* getArg() const
+    {
+      return m_arg;
+    }
+
+  private:
+    Name m_name;
+    port::Clock::Time m_sendTime;
+    port::Clock::Time m_expiry;
+    TimeoutCallback m_timeoutCb = nullptr;
+    void* m_arg = nullptr;
+    uint64_t m_token = 0;
+    uint32_t m_prev = NONE;
+    uint32_t m_next = NONE;
+    uint32_t m_sameName = NONE; ///< next older entry with the same name
+    uint16_t m_gen = 0;
+    bool m_used = false;
+
+    friend PendingInterestTable;
+  };
+
+  /**
+   * @brief Constructor.
+   * @param region where to allocate the table.
+   * @param capacity maximum number of entries, less than 2^32-1.
+   * @param maxNameLength maximum TLV-VALUE length of stored Interest names. If zero, names are
+   *                      not stored and lookup by name is unavailable.
+   * @post `!*this` if allocation fails.
+   */
+  explicit PendingInterestTable(Region& region, uint32_t capacity, size_t maxNameLength = 0)
+    : m_names(region, maxNameLength > 0 ? capacity : 0)
+    , m_maxNameLength(maxNameLength)
+  {
+    m_entries = reinterpret_cast<Entry*>(region.allocA(sizeof(Entry) * capacity));
+    m_nameBuf = region.alloc(maxNameLength * capacity);
+    if (m_entries == nullptr || (maxNameLength > 0 && (m_nameBuf == nullptr || !m_names))) {
+      m_entries = nullptr;
+      return;
+    }
+
+    for (uint32_t i = capacity; i > 0; --i) {
+      Entry* entry = new (&m_entries[i - 1]) Entry();
+      entry->m_next = m_free;
+      m_free = i - 1;
+    }
+    m_capacity = capacity;
+
+    uint16_t tag = 0;
+    port::RandomSource::generate(reinterpret_cast<uint8_t*>(&tag), sizeof(tag));
+    m_tag = static_cast<uint64_t>(tag) << 48;
+  }
+
+  explicit operator bool() const
+  {
+    return m_entries != nullptr;
+  }
+
+  /** @brief Return number of entries. */
+  uint32_t size() const
+  {
+    return m_size;
+  }
+
+  /** @brief Return maximum number of entries. */
+  uint32_t capacity() const
+  {
+    return m_capacity;
+  }
+
+  /**
+   * @brief Insert an entry.
+   * @param name Interest name. It is copied if the table has name storage.
+   * @param timeout timeout in milliseconds, typically InterestLifetime.
+   * @param timeoutCb callback when the entry expires, may be nullptr.
+   * @param arg argument passed to @p timeoutCb .
+   * @return the entry, or nullptr if the table is full or the name is too long to be stored.
+   */
+  Entry* insert(const Name& name, int timeout, TimeoutCallback timeoutCb = nullptr,
+                void* arg = nullptr)
+  {
+    if (m_free == NONE || (m_maxNameLength > 0 && name.length() > m_maxNameLength)) {
+      return nullptr;
+    }
+    uint32_t index = m_free;
+    Entry* entry = &m_entries[index];
+    m_free = entry->m_next;
+
+    entry->m_used = true;
+    if (++entry->m_gen == 0) {
+      ++entry->m_gen;
+    }
+    entry->m_token = m_tag | (static_cast<uint64_t>(entry->m_gen) << 32) | index;
+    entry->m_sendTime = port::Clock::now();
+    entry->m_expiry = port::Clock::add(entry->m_sendTime, timeout);
+    entry->m_timeoutCb = timeoutCb;
+    entry->m_arg = arg;
+    if (m_maxNameLength > 0) {
+      uint8_t* buf = &m_nameBuf[m_maxNameLength * index];
+      std::copy_n(name.value(), name.length(), buf);
+      entry->m_name = Name(buf, name.length());
+      uint32_t* mapped = m_names.find(entry->m_name);
+      if (mapped != nullptr) { // older entry becomes reachable again when this one is erased
+        entry->m_sameName = *mapped;
+        m_names.erase(mapped);
+      }
+      m_names.insert(entry->m_name, index);
+    }
+    linkExpiry(index);
+    ++m_size;
+    return entry;
+  }
+
+  /**
+   * @brief Find an entry by PIT token.
+   * @return the entry, or nullptr if not found.
+   */
+  Entry* find(uint64_t pitToken) const
+  {
+    uint32_t index = pitToken & 0xFFFFFFFF;
+    if ((pitToken & TagMask) != m_tag || index >= m_capacity) {
+      return nullptr;
+    }
+    Entry* entry = &m_entries[index];
+    return entry->m_used && entry->m_token == pitToken ? entry : nullptr;
+  }
+
+  /**
+   * @brief Find an entry by Interest name.
+   * @pre the table has name storage.
+   */
+  Entry* findName(const Name& name) const
+  {
+    const uint32_t* index = m_names.find(name);
+    return index == nullptr ? nullptr : &m_entries[*index];
+  }
+
+  /**
+   * @brief Find an entry satisfied by incoming Data.
+   * @param pitToken PIT token of the incoming Data.
+   *
+   * An entry found by PIT token is accepted if its stored name, when available, is a prefix of
+   * the Data name. Otherwise, if the table has name storage, the longest entry name that is a
+   * prefix of the Data name is accepted. Interest selectors are not checked.
+   */
+  Entry* findData(uint64_t pitToken, const Data& data) const
+  {
+    const Name& dataName = data.getName();
+    Entry* entry = find(pitToken);
+    if (entry != nullptr && (m_maxNameLength == 0 || entry->m_name.isPrefixOf(dataName))) {
+      return entry;
+    }
+    if (m_maxNameLength == 0) {
+      return nullptr;
+    }
+
+    uint64_t hashes[NDNPH_PIT_MAXCOMPS];
+    size_t lengths[NDNPH_PIT_MAXCOMPS];
+    size_t n = NameHash::prefixes(dataName, hashes, NDNPH_PIT_MAXCOMPS, lengths);
+    for (size_t i = n; i-- > 0;) {
+      const uint32_t* index = m_names.findPrefix(dataName, hashes[i], lengths[i]);
+      if (index != nullptr) {
+        return &m_entries[*index];
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * @brief Find an entry matching incoming Nack.
+   * @param pitToken PIT token of the incoming Nack.
+   */
+  Entry* findNack(uint64_t pitToken, const Nack& nack) const
+  {
+    const Name& name = nack.getInterest().getName();
+    Entry* entry = find(pitToken);
+    if (entry != nullptr && (m_maxNameLength == 0 || entry->m_name == name)) {
+      return entry;
+    }
+    return m_maxNameLength == 0 ? nullptr : findName(name);
+  }
+
+  /**
+   * @brief Erase an entry.
+   * @param entry an entry in this table. It becomes invalid.
+   */
+  void erase(Entry* entry)
+  {
+    uint32_t index = entry - m_entries;
+    assert(index < m_capacity && entry->m_used);
+    unlinkExpiry(index);
+    if (m_maxNameLength > 0) {
+      unmapName(index);
+    }
+
+    uint16_t gen = entry->m_gen;
+    *entry = Entry();
+    entry->m_gen = gen;
+    entry->m_next = m_free;
+    m_free = index;
+    --m_size;
+  }
+
+  /**
+   * @brief Process expired entries.
+   * @param now current time.
+   * @return number of expired entries.
+   *
+   * For each expired entry, its timeout callback is invoked, and then it is erased.
+   * This should be invoked periodically, such as in PacketHandler::loop().
+   */
+  size_t processTimeouts(port::Clock::Time now = port::Clock::now())
+  {
+    size_t n = 0;
+    while (m_head != NONE && !port::Clock::isBefore(now, m_entries[m_head].m_expiry)) {
+      Entry* entry = &m_entries[m_head];
+      uint64_t token = entry->m_token;
+      if (entry->m_timeoutCb != nullptr) {
+        entry->m_timeoutCb(entry->m_arg, *entry);
+      }
+      if (entry->m_used && entry->m_token == token) { // callback may have erased the entry
+        erase(entry);
+      }
+      ++n;
+    }
+    return n;
+  }
+
+private:
+  /** @brief Insert into expiration list, scanning from the tail. */
+  void linkExpiry(uint32_t index)
+  {
+    Entry* entry = &m_entries[index];
+    uint32_t prev = m_tail;
+    while (prev != NONE && port::Clock::isBefore(entry->m_expiry, m_entries[prev].m_expiry)) {
+      prev = m_entries[prev].m_prev;
+    }
+    uint32_t next = prev == NONE ? m_head : m_entries[prev].m_next;
+    entry->m_prev = prev;
+    entry->m_next = next;
+    (prev == NONE ? m_head : m_entries[prev].m_next) = index;
+    (next == NONE ? m_tail : m_entries[next].m_prev) = index;
+  }
+
+  void unlinkExpiry(uint32_t index)
+  {
+    Entry* entry = &m_entries[index];
+    (entry->m_prev == NONE ? m_head : m_entries[entry->m_prev].m_next) = entry->m_next;
+    (entry->m_next == NONE ? m_tail : m_entries[entry->m_next].m_prev) = entry->m_prev;
+  }
+
+  /**
+   * @brief Remove an entry from name lookup.
+   *
+   * The name map refers to the newest entry and its name buffer. If that entry is erased, the
+   * map is rekeyed to the next older entry with the same name. Otherwise, the entry is unlinked
+   * from the list of older entries.
+   */
+  void unmapName(uint32_t index)
+  {
+    Entry* entry = &m_entries[index];
+    uint32_t* mapped = m_names.find(entry->m_name);
+    if (mapped == nullptr) {
+      return;
+    }
+    if (*mapped == index) {
+      m_names.erase(mapped);
+      if (entry->m_sameName != NONE) {
+        m_names.insert(m_entries[entry->m_sameName].m_name, entry->m_sameName);
+      }
+      return;
+    }
+    for (uint32_t i = *mapped; i != NONE; i = m_entries[i].m_sameName) {
+      if (m_entries[i].m_sameName == index) {
+        m_entries[i].m_sameName = entry->m_sameName;
+        return;
+      }
+    }
+  }
+
+private:
+  NameHashMap<uint32_t> m_names;
+  Entry* m_entries = nullptr;
+  uint8_t* m_nameBuf = nullptr;
+  size_t m_maxNameLength = 0;
+  uint64_t m_tag = 0;
+  uint32_t m_capacity = 0;
+  uint32_t m_size = 0;
+  uint32_t m_free = NONE;
+  uint32_t m_head = NONE;
+  uint32_t m_tail = NONE;
+};
+
+} // namespace ndnph
+
+#endif // NDNPH_FACE_PENDING_INTEREST_TABLE_HPP
@@ -0,0 +1,115 @@
+#ifndef NDNPH_FACE_RTT_ESTIMATOR_HPP
+#define NDNPH_FACE_RTT_ESTIMATOR_HPP
+
+#include "../port/clock/port.hpp"
+
+namespace ndnph {
+
+/**
+ * @brief Round-trip time estimator and retransmission timeout calculator.
+ *
+ * This follows RFC 6298 with clock granularity of 1 millisecond. SRTT and RTTVAR are kept in
+ * fixed point, so that no floating point arithmetic is needed.
+ *
+ * A consumer should only take RTT samples that unambiguously correspond to one transmission of
+ * an Interest (Karn's algorithm). When each transmission carries a distinct PIT token, a Data
+ * carrying the PIT token of the latest transmission is unambiguous even after retransmissions.
+ */
+class RttEstimator
+{
+public:
+  struct Options
+  {
+    /** @brief RTO before the first measurement, in milliseconds. */
+    int initRto = 1000;
+
+    /** @brief Minimum RTO, in milliseconds. */
+    int minRto = 200;
+
+    /** @brief Maximum RTO, including exponential backoff, in milliseconds. */
+    int maxRto = 60000;
+  };
+
+  explicit RttEstimator(const Options& opts)
+    : m_opts(opts)
+    , m_rto(clampRto(opts.initRto))
+  {}
+
+  explicit RttEstimator()
+    : RttEstimator(Options())
+  {}
+
+  /** @brief Determine whether at least one measurement has been taken. */
+  bool hasMeasurement() const
+  {
+    return m_srtt8 >= 0;
+  }
+
+  /** @brief Return smoothed RTT in milliseconds, or -1 if there is no measurement. */
+  int getSrtt() const
+  {
+    return m_srtt8 < 0 ? -1 : m_srtt8 >> 3;
+  }
+
+  /** @brief Return RTT variation in milliseconds, or -1 if there is no measurement. */
+  int getRttVar() const
+  {
+    return m_srtt8 < 0 ? -1 : m_rttvar4 >> 2;
+  }
+
+  /** @brief Return retransmission timeout in milliseconds, including backoff. */
+  int getRto() const
+  {
+    return m_rto;
+  }
+
+  /**
+   * @brief Add an RTT sample.
+   * @param rtt measured RTT in milliseconds.
+   *
+   * This recomputes RTO and cancels exponential backoff.
+   */
+  void addMeasurement(int rtt)
+  {
+    rtt = std::max(rtt, 0);
+    if (m_srtt8 < 0) {
+      m_srtt8 = rtt << 3;
+      m_rttvar4 = rtt << 1;
+    } else {
+      int err = rtt - (m_srtt8 >> 3);
+      m_srtt8 += err;
+      m_rttvar4 += std::abs(err) - (m_rttvar4 >> 2);
+    }
+    m_rto = clampRto((m_srtt8 >> 3) + std::max(1, m_rttvar4));
+  }
+
+  /** @brief Add an RTT sample from the send time of an Interest. */
+  void addMeasurement(port::Clock::Time sendTime, port::Clock::Time now = port::Clock::now())
+  {
+    addMeasurement(port::Clock::sub(now, sendTime));
+  }
+
+  /** @brief Double RTO after a retransmission timeout, up to maximum RTO. */
+  void backoff()
+  {
+    m_rto = clampRto(m_rto * 2);
+  }
+
+private:
+  int clampRto(int rto) const
+  {
+    return std::min(std::max(rto, m_opts.minRto), m_opts.maxRto);
+  }
+
+private:
+  Options m_opts;
+  /** @brief SRTT * 8, or -1 if there is no measurement. */
+  int m_srtt8 = -1;
+  /** @brief RTTVAR * 4. */
+  int m_rttvar4 = 0;
+  int m_rto = 0;
+};
+
+} // namespace ndnph
+
+#endif // NDNPH_FACE_RTT_ESTIMATOR_HPP
@@ -26,7 +26,7 @@ private:
   static void innerRx(void* self0, const uint8_t* pkt, size_t pktLen, uint64_t endpointId)
   {
     ForceEndpointId& self = *reinterpret_cast<ForceEndpointId*>(self0);
-    self.invokeRxCallback(pkt, pktLen, endpointId);
+    self.invokeRxCallback(pkt, pktLen, endpointId, self.m_inner.getRxRegion());
   }
 
   bool doIsUp() const final
@@ -44,6 +44,26 @@ private:
     return m_inner.send(pkt, pktLen, m_endpointId);
   }
 
+  bool doCanSendv() const final
+  {
+    return m_inner.canSendv();
+  }
+
+  bool doSendv(const tlv::Value* segs, size_t count, uint64_t) final
+  {
+    return m_inner.sendv(segs, count, m_endpointId);
+  }
+
+  RxBufferRef doRetainRx() final
+  {
+    return m_inner.retainRx();
+  }
+
+  size_t doFlush() final
+  {
+    return m_inner.flush();
+  }
+
 private:
   Transport& m_inner;
   uint64_t m_endpointId = 0;
@@ -26,10 +26,13 @@ protected:
   /**
    * @brief Allocate receive buffers during initialization.
    * @tparam F `Region* (*)()`
+   * @param rxRoom space in each Region excluded from receive buffer, which can be used by
+   *               Face for decoding packets in place so that they can be retained.
    */
   template<typename F>
-  void initAllocBuffers(const F& makeRegion)
+  void initAllocBuffers(const F& makeRegion, size_t rxRoom = 0)
   {
+    m_rxRoom = rxRoom;
     for (size_t i = 0; i < NDNPH_TRANSPORT_RXQUEUELEN; ++i) {
       RxQueueItem item;
       item.region = makeRegion();
@@ -48,11 +51,7 @@ protected:
       bool ok = false;
       std::tie(m_item, ok) = transport.m_allocQ.pop();
       if (ok) {
-        Region& region = *m_item.region;
-        region.reset();
-        m_bufLen = region.available();
-        m_item.pkt = region.alloc(m_bufLen);
-        m_item.pktLen = -1;
+        m_bufLen = transport.prepareBuffer(m_item);
       }
     }
 
@@ -89,6 +88,7 @@ protected:
     {
       m_item.pktLen = pktLen;
       m_item.endpointId = endpointId;
+      m_item.region->free(m_item.pkt + pktLen, m_item.pkt + m_bufLen);
     }
 
   private:
@@ -115,29 +115,175 @@ protected:
     return RxContext(*this);
   }
 
+  /** @brief Receive buffer in a burst. */
+  struct RxBuffer
+  {
+    uint8_t* buf = nullptr;
+    size_t bufLen = 0;
+    /** @brief Packet length, set by receiver. */
+    size_t pktLen = 0;
+    /** @brief Endpoint identifier, set by receiver. */
+    uint64_t endpointId = 0;
+  };
+
+  /**
+   * @brief Receive a burst of packets.
+   * @tparam F `size_t (*)(RxBuffer* bufs, size_t count)`, which fills received packets in the
+   *           first several buffers and returns how many have been filled.
+   * @param maxCount maximum burst size, capped by NDNPH_TRANSPORT_RXQUEUELEN and the number of
+   *                 available buffers.
+   * @return number of received packets.
+   *
+   * @code
+   * while (receivingBurst(BurstSize, [this](RxBuffer* bufs, size_t count) {
+   *   return receiveInto(bufs, count);
+   * }) == BurstSize) {
+   * }
+   * @endcode
+   */
+  template<typename F>
+  size_t receivingBurst(size_t maxCount, const F& f)
+  {
+    RxQueueItem items[NDNPH_TRANSPORT_RXQUEUELEN];
+    RxBuffer bufs[NDNPH_TRANSPORT_RXQUEUELEN];
+    maxCount = std::min<size_t>(maxCount, NDNPH_TRANSPORT_RXQUEUELEN);
+    size_t count = 0;
+    for (; count < maxCount; ++count) {
+      bool ok = false;
+      std::tie(items[count], ok) = m_allocQ.pop();
+      if (!ok) {
+        break;
+      }
+      bufs[count].bufLen = prepareBuffer(items[count]);
+      bufs[count].buf = items[count].pkt;
+      if (bufs[count].buf == nullptr) {
+        m_allocQ.push(items[count]);
+        break;
+      }
+    }
+    if (count == 0) {
+      return 0;
+    }
+
+    size_t nRx = f(bufs, count);
+    for (size_t i = 0; i < count; ++i) {
+      RxQueueItem& item = items[i];
+      bool ok = false;
+      if (i < nRx) {
+        item.pktLen = bufs[i].pktLen;
+        item.endpointId = bufs[i].endpointId;
+        item.region->free(item.pkt + item.pktLen, item.pkt + bufs[i].bufLen);
+        ok = m_rxQ.push(item);
+      } else {
+        ok = m_allocQ.push(item);
+      }
+      assert(ok);
+      (void)ok;
+    }
+    return nRx;
+  }
+
   /**
    * @brief Process periodical events.
    *
-   * This delivers received packets to Face.
+   * This delivers received packets to Face in a burst.
    * This should be called in `loop()`.
    */
   void loopRxQueue()
   {
-    while (true) {
-      RxQueueItem item;
+    RxQueueItem items[NDNPH_TRANSPORT_RXQUEUELEN];
+    RxPacket pkts[NDNPH_TRANSPORT_RXQUEUELEN];
+    Retained* retained[NDNPH_TRANSPORT_RXQUEUELEN] = {};
+    size_t count = 0;
+    for (; count < NDNPH_TRANSPORT_RXQUEUELEN; ++count) {
       bool ok = false;
-      std::tie(item, ok) = m_rxQ.pop();
+      std::tie(items[count], ok) = m_rxQ.pop();
       if (!ok) {
         break;
       }
-      invokeRxCallback(item.pkt, item.pktLen, item.endpointId);
-      m_allocQ.push(item);
+      pkts[count].pkt = items[count].pkt;
+      pkts[count].pktLen = items[count].pktLen;
+      pkts[count].endpointId = items[count].endpointId;
+      pkts[count].rxRegion = items[count].region;
+    }
+    if (count == 0) {
+      return;
+    }
+
+    m_rxItems = items;
+    m_rxRetained = retained;
+    invokeRxBurstCallback(pkts, count);
+    m_rxItems = nullptr;
+    m_rxRetained = nullptr;
+
+    for (size_t i = 0; i < count; ++i) {
+      if (retained[i] == nullptr) {
+        m_allocQ.push(items[i]);
+      } else if (--retained[i]->nRefs == 0) {
+        // dropped the reference held during RX callback
+        releaseRetained(retained[i]);
+      }
+    }
+  }
+
+private:
+  struct Retained : RxBufferRef::Control
+  {
+    RxQueueMixin* transport;
+    RxQueueItem item;
+  };
+
+  RxBufferRef doRetainRx() override
+  {
+    if (m_rxItems == nullptr) {
+      return RxBufferRef();
+    }
+    size_t i = getRxIndex();
+    Retained*& retained = m_rxRetained[i];
+    if (retained == nullptr) {
+      retained = m_rxItems[i].region->make<Retained>();
+      if (retained == nullptr) {
+        return RxBufferRef();
+      }
+      retained->release = releaseRetained;
+      retained->nRefs = 1; // reference held during RX callback
+      retained->transport = this;
+      retained->item = m_rxItems[i];
     }
+    return RxBufferRef(retained);
+  }
+
+  /**
+   * @brief Allocate receive buffer in the Region of a popped item.
+   * @return buffer length; item.pkt is nullptr if allocation fails.
+   *
+   * If the Region spans multiple chunks, the buffer is placed in the largest chunk available.
+   */
+  size_t prepareBuffer(RxQueueItem& item)
+  {
+    Region& region = *item.region;
+    region.reset();
+    region.enlarge();
+    size_t bufLen = std::max(region.availableA(), m_rxRoom) - m_rxRoom;
+    item.pkt = region.allocA(bufLen);
+    item.pktLen = -1;
+    return bufLen;
+  }
+
+  static void releaseRetained(RxBufferRef::Control* c)
+  {
+    Retained* self = static_cast<Retained*>(c);
+    bool ok = self->transport->m_allocQ.push(self->item);
+    assert(ok);
+    (void)ok;
   }
 
 private:
   port::SafeQueue<RxQueueItem, NDNPH_TRANSPORT_RXQUEUELEN> m_allocQ;
   port::SafeQueue<RxQueueItem, NDNPH_TRANSPORT_RXQUEUELEN> m_rxQ;
+  size_t m_rxRoom = 0;
+  RxQueueItem* m_rxItems = nullptr;
+  Retained** m_rxRetained = nullptr;
 };
 
 /**
@@ -152,11 +298,12 @@ protected:
   /**
    * @brief Constructor.
    * @param bufLen buffer length, typically MTU.
+   * @param rxRoom additional space for decoding packets in place.
    */
-  explicit DynamicRxQueueMixin(size_t bufLen = DEFAULT_BUFLEN)
-    : m_region(sizeofSubRegions(bufLen, NDNPH_TRANSPORT_RXQUEUELEN))
+  explicit DynamicRxQueueMixin(size_t bufLen = DEFAULT_BUFLEN, size_t rxRoom = 0)
+    : m_region(sizeofSubRegions(bufLen + rxRoom, NDNPH_TRANSPORT_RXQUEUELEN))
   {
-    this->initAllocBuffers([=] { return makeSubRegion(m_region, bufLen); });
+    this->initAllocBuffers([=] { return makeSubRegion(m_region, bufLen + rxRoom); }, rxRoom);
   }
 
 private:
@@ -0,0 +1,140 @@
+#ifndef NDNPH_FACE_TRANSPORT_TXQUEUE_HPP
+#define NDNPH_FACE_TRANSPORT_TXQUEUE_HPP
+
+#include "transport.hpp"
+
+namespace ndnph {
+namespace transport {
+
+/** @brief Outgoing packet in a burst. */
+struct TxPacket
+{
+  const uint8_t* pkt = nullptr;
+  size_t pktLen = 0;
+  uint64_t endpointId = 0;
+};
+
+/**
+ * @brief Mixin of TX batching in Transport.
+ *
+ * When TX batching is enabled, outgoing packets are copied into transport-owned buffers and
+ * transmitted in one burst during flush(), which Face invokes at the end of Face::loop().
+ * A subclass should attempt enqueueTx() in its send functions, and implement doSendBurst().
+ */
+class TxQueueMixin : public virtual Transport
+{
+public:
+  /**
+   * @brief Enable TX batching.
+   * @param depth maximum number of deferred packets. When exceeded, queued packets are flushed.
+   * @param bufLen buffer length of each deferred packet, typically MTU. Longer packets are not
+   *               deferred.
+   * @return whether success.
+   */
+  bool enableTxBatch(size_t depth, size_t bufLen = 1500)
+  {
+    if (depth == 0) {
+      return false;
+    }
+    flushTx();
+    m_bufLen = Region::sizeofAligned(bufLen);
+    m_buf.reset(new uint8_t[m_bufLen * depth]);
+    m_queue.reset(new TxPacket[depth]);
+    m_depth = depth;
+    return true;
+  }
+
+  /** @brief Disable TX batching, after transmitting queued packets. */
+  void disableTxBatch()
+  {
+    flushTx();
+    m_buf.reset();
+    m_queue.reset();
+    m_depth = 0;
+  }
+
+  /** @brief Return number of packets awaiting flush(). */
+  size_t countQueuedTx() const
+  {
+    return m_count;
+  }
+
+protected:
+  /**
+   * @brief Defer an outgoing packet.
+   * @param segs packet segments, concatenated in order.
+   * @retval true packet has been queued.
+   * @retval false TX batching is disabled or the packet is too long. Queued packets have been
+   *               flushed, so that the caller may transmit this packet directly.
+   */
+  bool enqueueTx(const tlv::Value* segs, size_t count, uint64_t endpointId)
+  {
+    if (m_depth == 0) {
+      return false;
+    }
+    size_t pktLen = 0;
+    for (size_t i = 0; i < count; ++i) {
+      pktLen += segs[i].size();
+    }
+    if (pktLen > m_bufLen) {
+      flushTx();
+      return false;
+    }
+    if (m_count == m_depth) {
+      flushTx();
+    }
+
+    uint8_t* buf = &m_buf[m_bufLen * m_count];
+    uint8_t* pos = buf;
+    for (size_t i = 0; i < count; ++i) {
+      pos = std::copy(segs[i].begin(), segs[i].end(), pos);
+    }
+    TxPacket& p = m_queue[m_count++];
+    p.pkt = buf;
+    p.pktLen = pktLen;
+    p.endpointId = endpointId;
+    return true;
+  }
+
+  /** @brief Defer an outgoing packet. */
+  bool enqueueTx(const uint8_t* pkt, size_t pktLen, uint64_t endpointId)
+  {
+    tlv::Value seg(pkt, pktLen);
+    return enqueueTx(&seg, 1, endpointId);
+  }
+
+  /** @brief Transmit queued packets. */
+  size_t flushTx()
+  {
+    if (m_count == 0) {
+      return 0;
+    }
+    size_t nSent = doSendBurst(m_queue.get(), m_count);
+    m_count = 0;
+    return nSent;
+  }
+
+private:
+  size_t doFlush() final
+  {
+    return flushTx();
+  }
+
+  /**
+   * @brief Transmit a burst of packets.
+   * @return number of successfully transmitted packets.
+   */
+  virtual size_t doSendBurst(const TxPacket* pkts, size_t count) = 0;
+
+private:
+  std::unique_ptr<uint8_t[]> m_buf;
+  std::unique_ptr<TxPacket[]> m_queue;
+  size_t m_bufLen = 0;
+  size_t m_depth = 0;
+  size_t m_count = 0;
+};
+
+} // namespace transport
+} // namespace ndnph
+
+#endif // NDNPH_FACE_TRANSPORT_TXQUEUE_HPP
@@ -1,11 +1,87 @@
 #ifndef NDNPH_FACE_TRANSPORT_HPP
 #define NDNPH_FACE_TRANSPORT_HPP
 
-#include "../core/region.hpp"
+#include "../tlv/value.hpp"
 
 namespace ndnph {
 namespace transport {
 
+/**
+ * @brief Reference-counted handle of a retained RX buffer.
+ *
+ * The packet buffer and objects allocated in its Region remain valid while any handle exists.
+ * Handles must be copied and destructed on the thread that invokes Transport::loop().
+ */
+class RxBufferRef
+{
+public:
+  /** @brief Shared state of a retained RX buffer, allocated by the transport. */
+  struct Control
+  {
+    /** @brief Function to return the buffer to the transport when last handle is released. */
+    void (*release)(Control* self);
+    uint32_t nRefs;
+  };
+
+  RxBufferRef() = default;
+
+  explicit RxBufferRef(Control* c)
+    : m_c(c)
+  {
+    if (m_c != nullptr) {
+      ++m_c->nRefs;
+    }
+  }
+
+  RxBufferRef(const RxBufferRef& other)
+    : RxBufferRef(other.m_c)
+  {}
+
+  RxBufferRef(RxBufferRef&& other) noexcept
+    : m_c(other.m_c)
+  {
+    other.m_c = nullptr;
+  }
+
+  RxBufferRef& operator=(RxBufferRef other) noexcept
+  {
+    std::swap(m_c, other.m_c);
+    return *this;
+  }
+
+  ~RxBufferRef()
+  {
+    reset();
+  }
+
+  explicit operator bool() const
+  {
+    return m_c != nullptr;
+  }
+
+  /** @brief Release this reference. */
+  void reset()
+  {
+    if (m_c != nullptr && --m_c->nRefs == 0) {
+      m_c->release(m_c);
+    }
+    m_c = nullptr;
+  }
+
+private:
+  Control* m_c = nullptr;
+};
+
+/** @brief Received packet in a burst. */
+struct RxPacket
+{
+  const uint8_t* pkt = nullptr;
+  size_t pktLen = 0;
+  uint64_t endpointId = 0;
+  /** @brief Region that contains the packet buffer, if retainRx() is supported. */
+  Region* rxRegion = nullptr;
+};
+
 /** @brief Base class of low-level transport. */
 class Transport
 {
@@ -33,17 +109,129 @@ public:
     m_rxCtx = ctx;
   }
 
+  using RxBurstCallback = void (*)(void* ctx, const RxPacket* pkts, size_t count);
+
+  /**
+   * @brief Set incoming burst callback.
+   *
+   * If set, a transport that receives packets in bursts delivers each burst in one invocation.
+   * The callback should invoke selectRx() before processing each packet. Otherwise, each packet
+   * is delivered to the incoming packet callback.
+   */
+  void setRxBurstCallback(RxBurstCallback cb, void* ctx)
+  {
+    m_rxBurstCb = cb;
+    m_rxBurstCtx = ctx;
+  }
+
+  /**
+   * @brief Select a packet of the burst being delivered to RX burst callback.
+   * @pre RX burst callback is executing.
+   * @post getRxRegion() and retainRx() refer to the selected packet.
+   */
+  void selectRx(size_t i)
+  {
+    m_rxIndex = i;
+    m_rxRegion = m_rxBurst[i].rxRegion;
+  }
+
   /** @brief Synchronously transmit a packet. */
   bool send(const uint8_t* pkt, size_t pktLen, uint64_t endpointId = 0)
   {
     return doSend(pkt, pktLen, endpointId);
   }
 
+  /**
+   * @brief Transmit packets deferred by TX batching.
+   * @return number of transmitted packets.
+   *
+   * Face invokes this at the end of Face::loop().
+   */
+  size_t flush()
+  {
+    return doFlush();
+  }
+
+  /** @brief Determine whether sendv() is supported. */
+  bool canSendv() const
+  {
+    return doCanSendv();
+  }
+
+  /**
+   * @brief Synchronously transmit a packet given as a list of segments.
+   * @param segs packet segments, concatenated in order.
+   * @param count number of segments, no more than EncoderGather::MaxSegments.
+   * @pre canSendv() is true.
+   */
+  bool sendv(const tlv::Value* segs, size_t count, uint64_t endpointId = 0)
+  {
+    return doSendv(segs, count, endpointId);
+  }
+
+  /**
+   * @brief Access the Region that contains the packet being delivered to RX callback.
+   * @pre RX callback is executing.
+   * @return the Region, whose remaining space may be used for objects that should be retained
+   *         together with the packet; nullptr if unavailable.
+   */
+  Region* getRxRegion() const
+  {
+    return m_rxRegion;
+  }
+
+  /**
+   * @brief Retain the packet being delivered to RX callback.
+   * @pre RX callback is executing.
+   * @return a handle that keeps the packet buffer and getRxRegion() valid after RX callback
+   *         returns; empty handle if unsupported.
+   */
+  RxBufferRef retainRx()
+  {
+    return m_rxRegion == nullptr ? RxBufferRef() : doRetainRx();
+  }
+
 protected:
-  /** @brief Invoke incoming packet callback for a received packet. */
-  void invokeRxCallback(const uint8_t* pkt, size_t pktLen, uint64_t endpointId = 0)
+  /**
+   * @brief Invoke incoming packet callback for a received packet.
+   * @param rxRegion Region that contains the packet buffer, if retainRx() is supported.
+   */
+  void invokeRxCallback(const uint8_t* pkt, size_t pktLen, uint64_t endpointId = 0,
+                        Region* rxRegion = nullptr)
   {
+    m_rxIndex = 0;
+    m_rxRegion = rxRegion;
     m_rxCb(m_rxCtx, pkt, pktLen, endpointId);
+    m_rxRegion = nullptr;
+  }
+
+  /**
+   * @brief Invoke incoming burst callback for received packets.
+   *
+   * If burst callback is unset, the incoming packet callback is invoked for each packet.
+   */
+  void invokeRxBurstCallback(const RxPacket* pkts, size_t count)
+  {
+    m_rxBurst = pkts;
+    if (m_rxBurstCb != nullptr) {
+      m_rxBurstCb(m_rxBurstCtx, pkts, count);
+    } else {
+      for (size_t i = 0; i < count; ++i) {
+        selectRx(i);
+        m_rxCb(m_rxCtx, pkts[i].pkt, pkts[i].pktLen, pkts[i].endpointId);
+      }
+    }
+    m_rxBurst = nullptr;
+    m_rxRegion = nullptr;
+  }
+
+  /**
+   * @brief Return index of the packet being delivered within current burst.
+   * @pre RX callback or RX burst callback is executing.
+   */
+  size_t getRxIndex() const
+  {
+    return m_rxIndex;
   }
 
 private:
@@ -53,9 +241,34 @@ private:
 
   virtual bool doSend(const uint8_t* pkt, size_t pktLen, uint64_t endpointId) = 0;
 
+  virtual bool doCanSendv() const
+  {
+    return false;
+  }
+
+  virtual bool doSendv(const tlv::Value*, size_t, uint64_t)
+  {
+    return false;
+  }
+
+  virtual size_t doFlush()
+  {
+    return 0;
+  }
+
+  virtual RxBufferRef doRetainRx()
+  {
+    return RxBufferRef();
+  }
+
 private:
   RxCallback m_rxCb = nullptr;
   void* m_rxCtx = nullptr;
+  RxBurstCallback m_rxBurstCb = nullptr;
+  void* m_rxBurstCtx = nullptr;
+  const RxPacket* m_rxBurst = nullptr;
+  size_t m_rxIndex = 0;
+  Region* m_rxRegion = nullptr;
 };
 
 } // namespace transport
@@ -36,9 +36,12 @@ public:
   DataSigned* sig = nullptr;
   Name name;
   tlv::Value content;
+  tlv::Value pending; ///< whole packet whose fields other than Name are not yet decoded
   uint32_t freshnessPeriod = DefaultFreshnessPeriod;
   uint8_t contentType = DefaultContentType;
   bool isFinalBlock = false;
+  bool lazyDecode = false;
+  bool lazyFailed = false; ///< deferred decoding has failed
 };
 
 class SignedDataRef : public RefRegion<DataObj>
@@ -61,18 +64,42 @@ public:
       return;
     }
 
+    // Signature length is unknown until signing. To avoid moving Name and Content afterwards,
+    // sign over chunks: Name and Content are referenced in place, while MetaInfo and SigInfo
+    // are provisionally encoded next to the signature buffer and re-encoded later.
     const uint8_t* afterSig = encoder.begin();
     size_t maxSigLen = m_key->getMaxSigLen();
     uint8_t* sigBuf = encoder.prependRoom(maxSigLen);
-    encoder.prependTypeLength(TT::DSigValue, maxSigLen);
-    const uint8_t* afterSignedPortion = encoder.begin();
-    encodeSignedPortion(encoder);
+    const uint8_t* afterSigInfo = encoder.begin();
+    encoder.prepend(m_sigInfo);
+    const uint8_t* afterMetaInfo = encoder.begin();
+    encodeMetaInfo(encoder);
     if (!encoder) {
       return;
     }
+    tlv::Value metaInfo(encoder.begin(), afterMetaInfo);
+    tlv::Value sigInfo(afterMetaInfo, afterSigInfo);
+
+    uint8_t nameTL[10];
+    tlv::Value nameHdr(nameTL, tlv::writeTypeLength(nameTL, TT::Name, obj->name.length()));
+    tlv::Value nameValue(obj->name.value(), obj->name.length());
+    uint8_t contentTL[10];
+    tlv::Value contentHdr(contentTL, obj->content.size() == 0 ? 0
+                                       : tlv::writeTypeLength(contentTL, TT::Content,
+                                                              obj->content.size()));
+
+    size_t signedSize = nameHdr.size() + nameValue.size() + metaInfo.size() + contentHdr.size() +
+                        obj->content.size() + sigInfo.size();
+    size_t maxSize =
+      tlv::sizeofTlv(TT::Data, signedSize + tlv::sizeofTlv(TT::DSigValue, maxSigLen));
+    if (encoder.available() + (afterSig - encoder.begin()) < maxSize) {
+      // insufficient room for final encoding, fail before signing
+      encoder.setError();
+      return;
+    }
 
-    tlv::Value signedPortion(encoder.begin(), afterSignedPortion);
-    ssize_t sigLen = m_key->sign({ signedPortion }, sigBuf);
+    ssize_t sigLen =
+      m_key->sign({ nameHdr, nameValue, metaInfo, contentHdr, obj->content, sigInfo }, sigBuf);
     if (sigLen < 0) {
       encoder.setError();
       return;
@@ -80,14 +107,7 @@ public:
 
     encoder.resetFront(const_cast<uint8_t*>(afterSig));
     encoder.prependTlv(
-      TT::Data,
-      [=](Encoder& encoder) {
-        uint8_t* room = encoder.prependRoom(signedPortion.size());
-        assert(room != nullptr);
-        if (room != signedPortion.begin()) {
-          std::memmove(room, signedPortion.begin(), signedPortion.size());
-        }
-      },
+      TT::Data, [this](Encoder& encoder) { encodeSignedPortion(encoder); },
       [=](Encoder& encoder) {
         uint8_t* room = encoder.prependRoom(sigLen);
         assert(room != nullptr);
@@ -99,32 +119,36 @@ public:
   }
 
 private:
-  void encodeSignedPortion(Encoder& encoder) const
+  void encodeMetaInfo(Encoder& encoder) const
   {
-    encoder.prepend(
-      obj->name,
+    encoder.prependTlv(
+      TT::MetaInfo, Encoder::OmitEmpty,
       [this](Encoder& encoder) {
-        encoder.prependTlv(
-          TT::MetaInfo, Encoder::OmitEmpty,
-          [this](Encoder& encoder) {
-            if (obj->contentType != DataObj::DefaultContentType) {
-              encoder.prependTlv(TT::ContentType, tlv::NNI(obj->contentType));
-            }
-          },
-          [this](Encoder& encoder) {
-            if (obj->freshnessPeriod != DataObj::DefaultFreshnessPeriod) {
-              encoder.prependTlv(TT::FreshnessPeriod, tlv::NNI(obj->freshnessPeriod));
-            }
-          },
-          [this](Encoder& encoder) {
-            if (obj->isFinalBlock) {
-              auto comp = obj->name[-1];
-              encoder.prependTlv(TT::FinalBlock, tlv::Value(comp.tlv(), comp.size()));
-            }
-          });
+        if (obj->contentType != DataObj::DefaultContentType) {
+          encoder.prependTlv(TT::ContentType, tlv::NNI(obj->contentType));
+        }
       },
       [this](Encoder& encoder) {
-        encoder.prependTlv(TT::Content, Encoder::OmitEmpty, obj->content);
+        if (obj->freshnessPeriod != DataObj::DefaultFreshnessPeriod) {
+          encoder.prependTlv(TT::FreshnessPeriod, tlv::NNI(obj->freshnessPeriod));
+        }
+      },
+      [this](Encoder& encoder) {
+        if (obj->isFinalBlock) {
+          auto comp = obj->name[-1];
+          encoder.prependTlv(TT::FinalBlock, tlv::Value(comp.tlv(), comp.size()));
+        }
+      });
+  }
+
+  void encodeSignedPortion(Encoder& encoder) const
+  {
+    encoder.prepend(
+      obj->name, [this](Encoder& encoder) { encodeMetaInfo(encoder); },
+      [this](Encoder& encoder) {
+        encoder.prependTlv(TT::Content, Encoder::OmitEmpty, [this](Encoder& encoder) {
+          encoder.prependRef(obj->content.begin(), obj->content.size());
+        });
       },
       m_sigInfo);
   }
@@ -156,41 +180,49 @@ public:
 
   uint8_t getContentType() const
   {
+    finishDecode();
     return obj->contentType;
   }
 
   void setContentType(uint8_t v)
   {
+    finishDecode();
     obj->contentType = v;
   }
 
   uint32_t getFreshnessPeriod() const
   {
+    finishDecode();
     return obj->freshnessPeriod;
   }
 
   void setFreshnessPeriod(uint32_t v)
   {
+    finishDecode();
     obj->freshnessPeriod = v;
   }
 
   bool getIsFinalBlock() const
   {
+    finishDecode();
     return obj->isFinalBlock;
   }
 
   void setIsFinalBlock(bool v)
   {
+    finishDecode();
     obj->isFinalBlock = v;
   }
 
   tlv::Value getContent() const
   {
+    finishDecode();
     return obj->content;
   }
 
   void setContent(tlv::Value v)
   {
+    finishDecode();
     obj->content = std::move(v);
   }
 
@@ -200,6 +232,7 @@ public:
    */
   const DSigInfo* getSigInfo() const
   {
+    finishDecode();
     return obj->sig == nullptr ? nullptr : &obj->sig->sigInfo;
   }
 
@@ -209,38 +242,70 @@ public:
    */
   void encodeTo(Encoder& encoder) const
   {
+    finishDecode();
     if (obj->sig == nullptr) {
       encoder.setError();
       return;
     }
-    obj->sig->wholePacket.encodeTo(encoder);
+    encoder.prependRef(obj->sig->wholePacket.begin(), obj->sig->wholePacket.size());
+  }
+
+  /**
+   * @brief Enable or disable lazy decoding.
+   *
+   * If enabled before decodeFrom(), only Name is decoded and validated upfront. Other fields are
+   * decoded upon first access through a getter, a setter, verify(), or encodeTo(). If that
+   * decoding fails, these fields are reset to default values, and finishDecode() returns false,
+   * so that a packet that would be rejected by eager decoding can be detected and dropped.
+   * This saves decoding work and region allocation when the packet is dropped after looking at
+   * the name.
+   */
+  void setLazyDecode(bool enable)
+  {
+    obj->lazyDecode = enable;
+  }
+
+  /**
+   * @brief Decode fields deferred by lazy decoding.
+   * @return whether success; true if there are no deferred fields.
+   *
+   * If this fails, fields other than Name have default values, signature-related functions
+   * report failure, and subsequent calls return false.
+   */
+  bool finishDecode() const
+  {
+    if (obj->pending.size() == 0) {
+      return !obj->lazyFailed;
+    }
+    Decoder::Tlv input;
+    Decoder::readTlv(input, obj->pending.begin(), obj->pending.end());
+    obj->pending = tlv::Value();
+    if (decodeFields(input, false)) {
+      return true;
+    }
+    obj->sig = nullptr;
+    obj->content = tlv::Value();
+    obj->freshnessPeriod = detail::DataObj::DefaultFreshnessPeriod;
+    obj->contentType = detail::DataObj::DefaultContentType;
+    obj->isFinalBlock = false;
+    obj->lazyFailed = true;
+    return false;
   }
 
   /** @brief Decode packet. */
   bool decodeFrom(const Decoder::Tlv& input)
   {
-    obj->sig = regionOf(obj).template make<detail::DataSigned>();
-    if (obj->sig == nullptr) {
+    if (!obj->lazyDecode) {
+      return decodeFields(input, true);
+    }
+
+    Decoder::Tlv d;
+    if (input.type != TT::Data || !Decoder::readTlv(d, input.value, input.value + input.length) ||
+        d.type != TT::Name || !obj->name.decodeFrom(d)) {
       return false;
     }
-    obj->sig->wholePacket = tlv::Value(input.tlv, input.size);
-    return EvDecoder::decode(
-      input, { TT::Data }, EvDecoder::def<TT::Name>(&obj->name),
-      EvDecoder::def<TT::MetaInfo>([this](const Decoder::Tlv& d) {
-        return EvDecoder::decode(d, {}, EvDecoder::defNni<TT::ContentType>(&obj->contentType),
-                                 EvDecoder::defNni<TT::FreshnessPeriod>(&obj->freshnessPeriod),
-                                 EvDecoder::def<TT::FinalBlock>([this](const Decoder::Tlv& d) {
-                                   auto comp = getName()[-1];
-                                   setIsFinalBlock(
-                                     d.length == comp.size() &&
-                                     std::equal(d.value, d.value + d.length, comp.tlv()));
-                                 }));
-      }),
-      EvDecoder::def<TT::Content>(&obj->content), EvDecoder::def<TT::DSigInfo>(&obj->sig->sigInfo),
-      EvDecoder::def<TT::DSigValue>([this, &input](const Decoder::Tlv& d) {
-        obj->sig->signedPortion = tlv::Value(input.value, d.tlv);
-        return obj->sig->sigValue.decodeFrom(d);
-      }));
+    obj->pending = tlv::Value(input.tlv, input.size);
+    return true;
   }
 
   /**
@@ -274,6 +339,7 @@ public:
    */
   Signed sign(const PrivateKey& key, DSigInfo sigInfo = DSigInfo()) const
   {
+    finishDecode();
     return Signed(obj, key, std::move(sigInfo));
   }
 
@@ -284,6 +350,7 @@ public:
    */
   bool verify(const PublicKey& key) const
   {
+    finishDecode();
     return obj->sig != nullptr && key.verify({ obj->sig->signedPortion },
                                              obj->sig->sigValue.begin(), obj->sig->sigValue.size());
   }
@@ -295,6 +362,7 @@ public:
    */
   bool computeImplicitDigest(uint8_t digest[NDNPH_SHA256_LEN]) const
   {
+    finishDecode();
     if (obj->sig == nullptr) {
       return false;
     }
@@ -323,6 +391,35 @@ public:
     return p.print(getName());
   }
 #endif
+
+private:
+  bool decodeFields(const Decoder::Tlv& input, bool wantName) const
+  {
+    obj->sig = regionOf(obj).template make<detail::DataSigned>();
+    if (obj->sig == nullptr) {
+      return false;
+    }
+    obj->sig->wholePacket = tlv::Value(input.tlv, input.size);
+    return EvDecoder::decode(
+      input, { TT::Data },
+      EvDecoder::def<TT::Name>(
+        [this, wantName](const Decoder::Tlv& d) { return !wantName || obj->name.decodeFrom(d); }),
+      EvDecoder::def<TT::MetaInfo>([this](const Decoder::Tlv& d) {
+        return EvDecoder::decode(d, {}, EvDecoder::defNni<TT::ContentType>(&obj->contentType),
+                                 EvDecoder::defNni<TT::FreshnessPeriod>(&obj->freshnessPeriod),
+                                 EvDecoder::def<TT::FinalBlock>([this](const Decoder::Tlv& d) {
+                                   auto comp = getName()[-1];
+                                   obj->isFinalBlock =
+                                     d.length == comp.size() &&
+                                     std::equal(d.value, d.value + d.length, comp.tlv());
+                                 }));
+      }),
+      EvDecoder::def<TT::Content>(&obj->content), EvDecoder::def<TT::DSigInfo>(&obj->sig->sigInfo),
+      EvDecoder::def<TT::DSigValue>([this, &input](const Decoder::Tlv& d) {
+        obj->sig->signedPortion = tlv::Value(input.value, d.tlv);
+        return obj->sig->sigValue.decodeFrom(d);
+      }));
+  }
 };
 
 #ifdef NDNPH_PRINT_OSTREAM
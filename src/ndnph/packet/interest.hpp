@@ -154,7 +154,8 @@ protected:
   void encodeName(Encoder& encoder, const tlv::Value& params) const
   {
     port::Sha256 hash;
-    hash.update(params.begin(), params.size());
+    encoder.gather(params.begin(), params.end(),
+                   [&hash](const uint8_t* buf, size_t size) { hash.update(buf, size); });
     uint8_t digestComp[34];
     if (!hash.final(&digestComp[2])) {
       encoder.setError();
@@ -179,7 +180,9 @@ protected:
 
   void encodeAppParameters(Encoder& encoder) const
   {
-    encoder.prependTlv(TT::AppParameters, m_appParameters);
+    encoder.prependTlv(TT::AppParameters, [this](Encoder& encoder) {
+      encoder.prependRef(m_appParameters.begin(), m_appParameters.size());
+    });
   }
 
   template<typename Fn>
@@ -236,18 +239,23 @@ public:
       return;
     }
 
+    // Signature length is unknown until signing. To avoid moving AppParameters afterwards,
+    // sign over chunks: AppParameters is referenced in place, while SigInfo is provisionally
+    // encoded next to the signature buffer and re-encoded later.
     const uint8_t* afterSig = encoder.begin();
     size_t maxSigLen = m_key->getMaxSigLen();
     uint8_t* sigBuf = encoder.prependRoom(maxSigLen);
-    encoder.prependTypeLength(TT::DSigValue, maxSigLen);
-    const uint8_t* afterSignedPortion = encoder.begin();
-    encoder.prepend([this](Encoder& encoder) { encodeAppParameters(encoder); }, m_sigInfo);
+    const uint8_t* afterSigInfo = encoder.begin();
+    encoder.prepend(m_sigInfo);
     if (!encoder) {
       return;
     }
+    tlv::Value sigInfo(encoder.begin(), afterSigInfo);
 
-    tlv::Value signedPortion(encoder.begin(), afterSignedPortion);
-    ssize_t sigLen = m_key->sign({ signedName, signedPortion }, sigBuf);
+    uint8_t paramsTL[10];
+    tlv::Value paramsHdr(paramsTL, tlv::writeTypeLength(paramsTL, TT::AppParameters,
+                                                        m_appParameters.size()));
+    ssize_t sigLen = m_key->sign({ signedName, paramsHdr, m_appParameters, sigInfo }, sigBuf);
     if (sigLen < 0) {
       encoder.setError();
       return;
@@ -255,22 +263,15 @@ public:
 
     encoder.resetFront(const_cast<uint8_t*>(afterSig));
     encodeImpl(encoder, [=](Encoder& encoder) {
-      encoder.prepend(
-        [=](Encoder& encoder) {
-          uint8_t* room = encoder.prependRoom(signedPortion.size());
-          assert(room != nullptr);
-          if (room != signedPortion.begin()) {
-            std::memmove(room, signedPortion.begin(), signedPortion.size());
-          }
-        },
-        [=](Encoder& encoder) {
-          uint8_t* room = encoder.prependRoom(sigLen);
-          assert(room != nullptr);
-          if (room != sigBuf) {
-            std::memmove(room, sigBuf, sigLen);
-          }
-          encoder.prependTypeLength(TT::ISigValue, sigLen);
-        });
+      encoder.prepend([this](Encoder& encoder) { encodeAppParameters(encoder); }, m_sigInfo,
+                      [=](Encoder& encoder) {
+                        uint8_t* room = encoder.prependRoom(sigLen);
+                        assert(room != nullptr);
+                        if (room != sigBuf) {
+                          std::memmove(room, sigBuf, sigLen);
+                        }
+                        encoder.prependTypeLength(TT::ISigValue, sigLen);
+                      });
     });
   }
 
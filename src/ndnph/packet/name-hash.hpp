@@ -0,0 +1,350 @@
+#ifndef NDNPH_PACKET_NAME_HASH_HPP
+#define NDNPH_PACKET_NAME_HASH_HPP
+
+#include "name.hpp"
+
+namespace ndnph {
+
+/**
+ * @brief Non-cryptographic hash of Name and its prefixes.
+ *
+ * The hash is computed over TLV-VALUE of the name, one component at a time, so that hashes of
+ * every prefix are available from a single pass. It is intended for hash tables, and must not be
+ * used where collision resistance is needed.
+ */
+class NameHash
+{
+public:
+  /** @brief Compute hash of a name. */
+  static uint64_t of(const Name& name)
+  {
+    uint64_t h = Seed;
+    forEachComp(name, [&h](const uint8_t* tlv, size_t size) {
+      h = absorb(h, tlv, size);
+      return true;
+    });
+    return finish(h);
+  }
+
+  /**
+   * @brief Compute hashes of all prefixes of a name.
+   * @param[out] hashes hashes[i] is the hash of the prefix with i+1 components,
+   *                    which equals `of(name.getPrefix(i + 1))`.
+   * @param[out] lengths if not nullptr, lengths[i] is TLV-VALUE length of that prefix.
+   * @param n capacity of @p hashes and @p lengths .
+   * @return number of written hashes, min(name.size(), n).
+   */
+  static size_t prefixes(const Name& name, uint64_t* hashes, size_t n, size_t* lengths = nullptr)
+  {
+    uint64_t h = Seed;
+    size_t i = 0, length = 0;
+    forEachComp(name, [&](const uint8_t* tlv, size_t size) {
+      if (i == n) {
+        return false;
+      }
+      h = absorb(h, tlv, size);
+      length += size;
+      if (lengths != nullptr) {
+        lengths[i] = length;
+      }
+      hashes[i++] = finish(h);
+      return true;
+    });
+    return i;
+  }
+
+private:
+  static constexpr uint64_t Seed = 0x9E3779B97F4A7C15;
+  static constexpr uint64_t Mul = 0xFF51AFD7ED558CCD;
+
+  /**
+   * @brief Walk over component TLVs of a valid Name.
+   * @tparam F `bool (*)(const uint8_t* tlv, size_t size)`, return false to stop.
+   *
+   * This avoids constructing Component objects, because the Name has been validated.
+   */
+  template<typename F>
+  static void forEachComp(const Name& name, const F& f)
+  {
+    const uint8_t* pos = name.value();
+    const uint8_t* end = pos + name.length();
+    while (pos < end) {
+      uint32_t type = 0, length = 0;
+      int sizeofTL = tlv::readTypeLength(pos, end - pos, type, length);
+      size_t size = sizeofTL + length;
+      if (sizeofTL <= 0 || !f(pos, size)) {
+        break;
+      }
+      pos += size;
+    }
+  }
+
+  static uint64_t rotl(uint64_t x, int r)
+  {
+    return (x << r) | (x >> (64 - r));
+  }
+
+  /** @brief Mix bytes of a component into state, 8 octets at a time. */
+  static uint64_t absorb(uint64_t h, const uint8_t* p, size_t size)
+  {
+    for (; size >= 8; p += 8, size -= 8) {
+      uint64_t w = 0;
+      std::memcpy(&w, p, 8);
+      h = rotl(h ^ w, 29) * Mul;
+    }
+    uint64_t w = size;
+    for (size_t i = 0; i < size; ++i) {
+      w = (w << 8) | p[i];
+    }
+    return rotl(h ^ w, 29) * Mul;
+  }
+
+  /** @brief Finalize state (MurmurHash3 fmix64). */
+  static uint64_t finish(uint64_t h)
+  {
+    h ^= h >> 33;
+    h *= Mul;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53;
+    h ^= h >> 33;
+    return h;
+  }
+};
+
+/**
+ * @brief Hash table keyed by Name, allocated from a Region.
+ * @tparam V value type, which must be trivially destructible.
+ *
+ * This is an open addressing table with linear probing. Keys are stored as Name objects that
+ * reference caller-owned memory; the caller must keep TLV-VALUE of each key alive while it is
+ * in the table. Erasing uses backward shift, so that lookups never encounter tombstones.
+ */
+template<typename V>
+class NameHashMap
+{
+public:
+  static_assert(std::is_trivially_destructible<V>::value, "");
+  static_assert(std::is_default_constructible<V>::value, "");
+
+  /**
+   * @brief Constructor.
+   * @param region where to allocate the slot array.
+   * @param capacity maximum number of entries.
+   * @post `!*this` if allocation fails.
+   */
+  explicit NameHashMap(Region& region, size_t capacity)
+    : m_capacity(capacity)
+  {
+    size_t nSlots = 4;
+    while (nSlots < capacity + capacity / 3 + 1) {
+      nSlots <<= 1;
+    }
+    m_slots = reinterpret_cast<Slot*>(region.allocA(sizeof(Slot) * nSlots));
+    if (m_slots == nullptr) {
+      return;
+    }
+    for (size_t i = 0; i < nSlots; ++i) {
+      new (&m_slots[i]) Slot();
+    }
+    m_mask = nSlots - 1;
+  }
+
+  explicit operator bool() const
+  {
+    return m_slots != nullptr;
+  }
+
+  /** @brief Return number of entries. */
+  size_t size() const
+  {
+    return m_size;
+  }
+
+  /** @brief Return maximum number of entries. */
+  size_t capacity() const
+  {
+    return m_capacity;
+  }
+
+  /**
+   * @brief Find an entry.
+   * @return pointer to value, or nullptr if not found.
+   */
+  V* find(const Name& name) const
+  {
+    return find(name, NameHash::of(name));
+  }
+
+  /**
+   * @brief Find an entry with precomputed hash.
+   * @param hash `NameHash::of(name)`.
+   */
+  V* find(const Name& name, uint64_t hash) const
+  {
+    return findPrefix(name, hash, name.length());
+  }
+
+  /**
+   * @brief Find an entry whose key is a prefix of a name.
+   * @param hash hash of the prefix, from `NameHash::prefixes()`.
+   * @param length TLV-VALUE length of the prefix, from `NameHash::prefixes()`.
+   *
+   * This avoids constructing the prefix Name during longest prefix match.
+   */
+  V* findPrefix(const Name& name, uint64_t hash, size_t length) const
+  {
+    size_t i = lookup(hash, name.value(), length);
+    return i > m_mask ? nullptr : &m_slots[i].value;
+  }
+
+  /**
+   * @brief Find an entry by hash and value, without reading key names.
+   * @tparam Pred `bool (*)(const V& value)`
+   * @param hash `NameHash::of(name)` of the key.
+   *
+   * This is useful when TLV-VALUE of the key may no longer be accessible.
+   */
+  template<typename Pred>
+  V* findIf(uint64_t hash, const Pred& pred) const
+  {
+    for (size_t i = static_cast<size_t>(hash) & m_mask; m_slots != nullptr && m_slots[i].used;
+         i = (i + 1) & m_mask) {
+      if (m_slots[i].hash == hash && pred(const_cast<const V&>(m_slots[i].value))) {
+        return &m_slots[i].value;
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * @brief Insert or overwrite an entry.
+   * @param name key; its TLV-VALUE must remain valid while the entry exists.
+   * @return pointer to stored value, or nullptr if table is full or uninitialized.
+   */
+  V* insert(const Name& name, const V& value)
+  {
+    if (m_slots == nullptr) {
+      return nullptr;
+    }
+    uint64_t hash = NameHash::of(name);
+    size_t i = static_cast<size_t>(hash) & m_mask;
+    for (; m_slots[i].used; i = (i + 1) & m_mask) {
+      if (m_slots[i].matches(hash, name.value(), name.length())) {
+        m_slots[i].value = value;
+        return &m_slots[i].value;
+      }
+    }
+    if (m_size >= m_capacity) {
+      return nullptr;
+    }
+    Slot& slot = m_slots[i];
+    slot.hash = hash;
+    slot.name = name;
+    slot.value = value;
+    slot.used = true;
+    ++m_size;
+    return &slot.value;
+  }
+
+  /**
+   * @brief Erase an entry.
+   * @return whether the entry existed.
+   */
+  bool erase(const Name& name)
+  {
+    size_t i = lookup(NameHash::of(name), name.value(), name.length());
+    if (i > m_mask) {
+      return false;
+    }
+    eraseAt(i);
+    return true;
+  }
+
+  /**
+   * @brief Erase an entry by value pointer.
+   * @param value pointer returned by find(), findIf(), or insert(), without table modification
+   *              since then.
+   */
+  void erase(V* value)
+  {
+    auto offset = reinterpret_cast<uint8_t*>(value) - reinterpret_cast<uint8_t*>(&m_slots[0].value);
+    eraseAt(offset / sizeof(Slot));
+  }
+
+  /** @brief Erase all entries. */
+  void clear()
+  {
+    for (size_t i = 0; m_slots != nullptr && i <= m_mask; ++i) {
+      m_slots[i] = Slot();
+    }
+    m_size = 0;
+  }
+
+  /**
+   * @brief Invoke a function on every entry.
+   * @tparam F `void (*)(const Name& name, V& value)`
+   *
+   * The function must not insert or erase entries.
+   */
+  template<typename F>
+  void forEach(const F& f)
+  {
+    for (size_t i = 0; m_slots != nullptr && i <= m_mask; ++i) {
+      if (m_slots[i].used) {
+        f(m_slots[i].name, m_slots[i].value);
+      }
+    }
+  }
+
+private:
+  struct Slot
+  {
+    bool matches(uint64_t h, const uint8_t* v, size_t length) const
+    {
+      return hash == h && name.length() == length && std::equal(v, v + length, name.value());
+    }
+
+    uint64_t hash = 0;
+    Name name;
+    V value{};
+    bool used = false;
+  };
+
+  void eraseAt(size_t i)
+  {
+    // backward shift: move subsequent entries of the probe sequence into the hole
+    for (size_t j = (i + 1) & m_mask; m_slots[j].used; j = (j + 1) & m_mask) {
+      size_t home = static_cast<size_t>(m_slots[j].hash) & m_mask;
+      if (((j - home) & m_mask) >= ((j - i) & m_mask)) {
+        m_slots[i] = m_slots[j];
+        i = j;
+      }
+    }
+    m_slots[i] = Slot();
+    --m_size;
+  }
+
+  /** @brief Locate slot index, or return a value greater than m_mask if not found. */
+  size_t lookup(uint64_t hash, const uint8_t* v, size_t length) const
+  {
+    if (m_slots == nullptr) {
+      return SIZE_MAX;
+    }
+    for (size_t i = static_cast<size_t>(hash) & m_mask; m_slots[i].used; i = (i + 1) & m_mask) {
+      if (m_slots[i].matches(hash, v, length)) {
+        return i;
+      }
+    }
+    return SIZE_MAX;
+  }
+
+private:
+  Slot* m_slots = nullptr;
+  size_t m_mask = 0;
+  size_t m_size = 0;
+  size_t m_capacity = 0;
+};
+
+} // namespace ndnph
+
+#endif // NDNPH_PACKET_NAME_HASH_HPP
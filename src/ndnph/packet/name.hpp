@@ -4,6 +4,21 @@
 #include "../core/input-iterator-pointer-proxy.hpp"
 #include "component.hpp"
 
+#ifndef NDNPH_NAME_MAXOFFSETS
+/**
+ * @brief Number of component offsets indexed in each Name.
+ *
+ * If positive, each Name records offsets of its first components, so that operator[], slice(),
+ * and getPrefix() locate those components without walking from the start. Each offset occupies
+ * two octets in the Name object. If zero, or if Name TLV-VALUE is longer than 65535 octets,
+ * components are located by walking.
+ *
+ * Regardless of this setting, the offset of the last component is always recorded, so that
+ * `name[-1]` does not walk.
+ */
+#define NDNPH_NAME_MAXOFFSETS 0
+#endif
+
 namespace ndnph {
 
 /**
@@ -59,8 +74,8 @@ public:
       return Name();
     }
 
-    size_t nComps = 0;
-    ssize_t length = parseUri(buf, bufLen, uri, uriLen, nComps);
+    size_t nComps = 0, lastOffset = 0;
+    ssize_t length = parseUri(buf, bufLen, uri, uriLen, nComps, lastOffset);
     if (length < 0) {
       region.free(buf, bufLen);
       return Name();
@@ -71,7 +86,7 @@ public:
       std::copy_backward(buf, buf + length, value + length);
       region.free(buf, bufLen - length);
     }
-    return Name(value, length, nComps);
+    return Name(value, length, nComps, lastOffset);
   }
 
   /** @brief Return true if Name is valid. */
@@ -145,9 +160,11 @@ public:
     if (isOutOfRange(i)) {
       return Component();
     }
-    auto it = begin();
-    std::advance(it, i);
-    return *it;
+    Decoder::Tlv d;
+    Decoder::readTlv(d, m_value + findComp(i), m_value + m_length);
+    Component comp;
+    comp.decodeFrom(d);
+    return comp;
   }
 
   /**
@@ -167,12 +184,21 @@ public:
       return Name();
     }
 
-    auto it = begin();
-    std::advance(it, first);
-    auto firstComp = *it;
-    std::advance(it, last - first - 1);
-    auto lastComp = *it; // inclusive last component
-    return Name(firstComp.tlv(), lastComp.tlv() + lastComp.size() - firstComp.tlv(), last - first);
+    size_t begin = findComp(first);
+    size_t end = static_cast<size_t>(last) == m_nComps ? m_length : findComp(last);
+    Name sub;
+    sub.m_value = m_value + begin;
+    sub.m_length = end - begin;
+    sub.m_nComps = last - first;
+    sub.m_lastOffset = findComp(last - 1) - begin;
+#if NDNPH_NAME_MAXOFFSETS > 0
+    size_t i = 0;
+    for (; hasIndex() && i < sub.m_nComps && first + i < MaxOffsets; ++i) {
+      sub.m_offsets[i] = m_offsets[first + i] - begin;
+    }
+    sub.indexComps(i);
+#endif
+    return sub;
   }
 
   /**
@@ -197,12 +223,13 @@ public:
   Name append(Region& region, std::initializer_list<Component> comps,
               bool errorOnEmptyComponent = false) const
   {
-    size_t nComps = m_nComps, length = m_length;
+    size_t nComps = m_nComps, length = m_length, lastOffset = m_lastOffset;
     for (const auto& comp : comps) {
       if (errorOnEmptyComponent && !comp) {
         return Name();
       }
       ++nComps;
+      lastOffset = length;
       length += comp.size();
     }
     uint8_t* value = region.alloc(length);
@@ -213,7 +240,7 @@ public:
         pos = std::copy_n(comp.tlv(), comp.size(), pos);
       }
     }
-    return Name(value, length, nComps);
+    return Name(value, length, nComps, lastOffset);
   }
 
   /**
@@ -317,11 +344,18 @@ public:
 #endif
 
 private:
-  explicit Name(const uint8_t* value, size_t length, size_t nComps)
+  explicit Name(const uint8_t* value, size_t length, size_t nComps, size_t lastOffset)
     : m_value(value)
     , m_length(length)
     , m_nComps(nComps)
-  {}
+    , m_lastOffset(lastOffset)
+  {
+#if NDNPH_NAME_MAXOFFSETS > 0
+    if (m_value != nullptr) {
+      indexComps(0);
+    }
+#endif
+  }
 
   bool decodeValue(const uint8_t* value, size_t length)
   {
@@ -330,25 +364,92 @@ private:
       return true;
     }
     m_value = nullptr;
-    m_length = m_nComps = 0;
+    m_length = m_nComps = m_lastOffset = 0;
     return false;
   }
 
   bool decodeComps(size_t length)
   {
-    Decoder decoder(m_value, length);
-    auto it = decoder.begin(), end = decoder.end();
-    for (; it != end; ++it) {
-      Component comp;
-      if (!it->decode(comp)) {
+    // same validation as Component::decodeFrom, without constructing Decoder::Tlv
+    const uint8_t* pos = m_value;
+    const uint8_t* end = m_value + length;
+    while (pos != end) {
+      uint32_t type = 0, compLength = 0;
+      int sizeofTL = tlv::readTypeLength(pos, end - pos, type, compLength);
+      if (sizeofTL == 0 || type == 0 || type > 0xFFFF ||
+          static_cast<size_t>(end - pos - sizeofTL) < compLength) {
         return false;
       }
-      m_length += it->size;
+#if NDNPH_NAME_MAXOFFSETS > 0
+      if (m_nComps < MaxOffsets && length <= UINT16_MAX) {
+        m_offsets[m_nComps] = pos - m_value;
+      }
+#endif
+      m_lastOffset = pos - m_value;
+      pos += sizeofTL + compLength;
       ++m_nComps;
     }
-    return !it.hasError();
+    m_length = length;
+    return true;
   }
 
+  /** @brief Return offset of component after the component at @p pos . */
+  size_t skipComp(size_t pos) const
+  {
+    uint32_t type = 0, length = 0;
+    int sizeofTL = tlv::readTypeLength(m_value + pos, m_length - pos, type, length);
+    return pos + sizeofTL + length;
+  }
+
+  /**
+   * @brief Find offset of i-th component.
+   * @pre i < m_nComps
+   */
+  size_t findComp(size_t i) const
+  {
+    if (i == m_nComps - 1) {
+      return m_lastOffset;
+    }
+    size_t pos = 0;
+#if NDNPH_NAME_MAXOFFSETS > 0
+    if (hasIndex()) {
+      if (i < MaxOffsets) {
+        return m_offsets[i];
+      }
+      pos = m_offsets[MaxOffsets - 1];
+      i -= MaxOffsets - 1;
+    }
+#endif
+    for (; i > 0; --i) {
+      pos = skipComp(pos);
+    }
+    return pos;
+  }
+
+#if NDNPH_NAME_MAXOFFSETS > 0
+  /** @brief Determine whether component offsets are indexed, i.e. they fit in uint16_t. */
+  bool hasIndex() const
+  {
+    return m_length <= UINT16_MAX;
+  }
+
+  /**
+   * @brief Index offsets of components from i-th component.
+   * @pre offsets of components before i are indexed.
+   */
+  void indexComps(size_t i)
+  {
+    if (!hasIndex()) {
+      return;
+    }
+    size_t pos = i == 0 ? 0 : skipComp(m_offsets[i - 1]);
+    for (; i < m_nComps && i < MaxOffsets; ++i) {
+      m_offsets[i] = pos;
+      pos = skipComp(pos);
+    }
+  }
+#endif
+
   bool isOutOfRange(int i, bool acceptPastEnd = false) const
   {
     return i < 0 ||
@@ -356,9 +457,10 @@ private:
   }
 
   static ssize_t parseUri(uint8_t* buf, size_t bufLen, const char* uri, size_t uriLen,
-                          size_t& nComps)
+                          size_t& nComps, size_t& lastOffset)
   {
     nComps = 0;
+    lastOffset = 0;
     if (uriLen <= 1) { // empty Name
       return 0;
     }
@@ -376,6 +478,7 @@ private:
         return -1;
       }
       ++nComps;
+      lastOffset = length;
       length += comp.size();
       uri = compEnd;
     }
@@ -386,6 +489,15 @@ private:
   const uint8_t* m_value = nullptr;
   size_t m_length = 0;
   size_t m_nComps = 0;
+  size_t m_lastOffset = 0; ///< offset of last component
+#if NDNPH_NAME_MAXOFFSETS > 0
+  enum
+  {
+    MaxOffsets = NDNPH_NAME_MAXOFFSETS,
+  };
+  static_assert(MaxOffsets <= 0xFFFF, "");
+  uint16_t m_offsets[MaxOffsets];
+#endif
 };
 
 inline bool
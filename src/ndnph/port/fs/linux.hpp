@@ -2,6 +2,7 @@
 #define NDNPH_PORT_FS_LINUX_HPP
 
 #include "../../core/common.hpp"
+#include "../../tlv/value.hpp"
 #include <fcntl.h>
 #include <libgen.h>
 #include <sys/stat.h>
@@ -151,11 +152,111 @@ private:
   size_t m_pathLen = 0;
 };
 
+/**
+ * @brief Positional writer into a file on Linux filesystem.
+ *
+ * Each chunk is written at its offset with pwrite(), so that the file position is irrelevant and
+ * nothing is buffered in memory. write() and complete() match the callbacks of
+ * SegmentConsumerBase::StreamDest.
+ */
+class FileWriter
+{
+public:
+  explicit FileWriter() = default;
+
+  /** @brief Construct from a file descriptor opened for writing; it is not closed by this. */
+  explicit FileWriter(int fd)
+    : m_fd(fd)
+  {}
+
+  ~FileWriter()
+  {
+    close();
+  }
+
+  FileWriter(const FileWriter&) = delete;
+  FileWriter& operator=(const FileWriter&) = delete;
+
+  /**
+   * @brief Create or truncate a file, and open it for writing.
+   * @return whether success.
+   */
+  bool open(const char* path)
+  {
+    close();
+    m_fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    m_ownFd = m_fd >= 0;
+    return m_ownFd;
+  }
+
+  /** @brief Close the file, if it was opened by open(). */
+  void close()
+  {
+    if (m_ownFd) {
+      ::close(m_fd);
+    }
+    m_fd = -1;
+    m_ownFd = false;
+  }
+
+  /** @brief Return file descriptor, or -1 if not open. */
+  int getFd() const
+  {
+    return m_fd;
+  }
+
+  /**
+   * @brief Write a chunk at an offset.
+   * @return whether success.
+   */
+  bool write(uint64_t offset, const uint8_t* buf, size_t count)
+  {
+    while (count > 0) {
+      ssize_t n = ::pwrite(m_fd, buf, count, static_cast<off_t>(offset));
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        return false;
+      }
+      buf += n;
+      count -= n;
+      offset += n;
+    }
+    return true;
+  }
+
+  /** @brief StreamDest write function, where @p self is FileWriter*. */
+  static bool write(void* self, uint64_t offset, tlv::Value chunk)
+  {
+    return static_cast<FileWriter*>(self)->write(offset, chunk.begin(), chunk.size());
+  }
+
+  /**
+   * @brief StreamDest completion function, where @p self is FileWriter*.
+   *
+   * Upon success, the file is truncated to the content size, in case it was longer.
+   */
+  static void complete(void* self, bool ok, uint64_t size)
+  {
+    auto writer = static_cast<FileWriter*>(self);
+    if (ok && writer->m_fd >= 0) {
+      int res = ::ftruncate(writer->m_fd, static_cast<off_t>(size));
+      (void)res;
+    }
+  }
+
+private:
+  int m_fd = -1;
+  bool m_ownFd = false;
+};
+
 } // namespace port_fs_linux
 
 #ifdef NDNPH_PORT_FS_LINUX
 namespace port {
 using FileStore = port_fs_linux::FileStore;
+using FileWriter = port_fs_linux::FileWriter;
 } // namespace port
 #endif
 
@@ -2,6 +2,7 @@
 #define NDNPH_PORT_TRANSPORT_MEMIF_HPP
 
 #include "../../face/transport-rxqueue.hpp"
+#include "../../face/transport-txqueue.hpp"
 extern "C"
 {
 #include <libmemif.h>
@@ -45,8 +46,13 @@ getEtherHdr()
  *
  * Current implementation only allows one memif transport per process.
  * It is compatible with NDN-DPDK dataplane, but has no management integration.
+ *
+ * If TX batching is enabled, deferred packets are written into multiple memif buffers and
+ * transmitted with one memif_tx_burst() call.
  */
-class MemifTransport : public virtual Transport
+class MemifTransport
+  : public virtual Transport
+  , public transport::TxQueueMixin
 {
 public:
   explicit MemifTransport(uint16_t maxPktLen = 8800)
@@ -147,6 +153,10 @@ private:
       return false;
     }
 
+    if (enqueueTx(pkt, pktLen, 0)) {
+      return true;
+    }
+
     memif_buffer_t b = {};
     uint16_t nAlloc = 0;
     int err = memif_buffer_alloc(m_conn, 0, &b, 1, &nAlloc, pktLen);
@@ -169,6 +179,52 @@ private:
     return true;
   }
 
+  size_t doSendBurst(const transport::TxPacket* pkts, size_t count) final
+  {
+    if (!m_isUp) {
+      return 0;
+    }
+
+    size_t nSent = 0;
+    while (nSent < count) {
+      static constexpr size_t BurstSize = 64;
+      std::array<memif_buffer_t, BurstSize> bufs{};
+      uint16_t n = std::min(count - nSent, BurstSize);
+      size_t maxLen = 0;
+      for (uint16_t i = 0; i < n; ++i) {
+        maxLen = std::max(maxLen, pkts[nSent + i].pktLen);
+      }
+
+      uint16_t nAlloc = 0;
+      int err = memif_buffer_alloc(m_conn, 0, bufs.data(), n, &nAlloc,
+                                   getEtherHdr().size() + maxLen);
+      if (nAlloc == 0) {
+        NDNPH_MEMIF_PRINT_ERR(memif_buffer_alloc);
+        break;
+      }
+
+      for (uint16_t i = 0; i < nAlloc; ++i) {
+        const transport::TxPacket& pkt = pkts[nSent + i];
+        memif_buffer_t& b = bufs[i];
+        uint8_t* p =
+          std::copy(getEtherHdr().begin(), getEtherHdr().end(), static_cast<uint8_t*>(b.data));
+        p = std::copy_n(pkt.pkt, pkt.pktLen, p);
+        b.len = std::distance(static_cast<uint8_t*>(b.data), p);
+      }
+
+      uint16_t nTx = 0;
+      err = memif_tx_burst(m_conn, 0, bufs.data(), nAlloc, &nTx);
+      if (err != MEMIF_ERR_SUCCESS) {
+        NDNPH_MEMIF_PRINT_ERR(memif_tx_burst);
+      }
+      nSent += nTx;
+      if (nTx < n) {
+        break;
+      }
+    }
+    return nSent;
+  }
+
   static int handleConnect(memif_conn_handle_t conn, void* self0)
   {
     MemifTransport* self = reinterpret_cast<MemifTransport*>(self0);
@@ -209,13 +265,19 @@ private:
       return 0;
     }
 
+    std::array<transport::RxPacket, NDNPH_MEMIF_RXBURST> pkts;
+    size_t count = 0;
     for (uint16_t i = 0; i < nRx; ++i) {
       const memif_buffer_t& b = burst[i];
       if (b.len <= getEtherHdr().size()) {
         continue;
       }
-      self->invokeRxCallback(std::next(static_cast<const uint8_t*>(b.data), getEtherHdr().size()),
-                             b.len - getEtherHdr().size());
+      transport::RxPacket& p = pkts[count++];
+      p.pkt = std::next(static_cast<const uint8_t*>(b.data), getEtherHdr().size());
+      p.pktLen = b.len - getEtherHdr().size();
+    }
+    if (count > 0) {
+      self->invokeRxBurstCallback(pkts.data(), count);
     }
 
     err = memif_refill_queue(conn, qid, nRx, 0);
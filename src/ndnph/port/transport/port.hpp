@@ -6,6 +6,7 @@
 #else
 
 #ifdef NDNPH_PORT_TRANSPORT_SOCKET
+#include "socket/udp-sharded.hpp"
 #include "socket/udp-unicast.hpp"
 #endif
 
@@ -0,0 +1,171 @@
+#ifndef NDNPH_PORT_TRANSPORT_SOCKET_UDP_SHARDED_HPP
+#define NDNPH_PORT_TRANSPORT_SOCKET_UDP_SHARDED_HPP
+
+#include "../../../face/face.hpp"
+#include "udp-unicast.hpp"
+
+#include <atomic>
+#include <pthread.h>
+#include <sched.h>
+#include <thread>
+#include <vector>
+
+namespace ndnph {
+namespace port_transport_socket {
+
+/**
+ * @brief UDP listener sharded across threads with SO_REUSEPORT.
+ *
+ * Each shard has its own socket, UdpUnicastTransport, and Face, which are used by one thread
+ * only. The kernel distributes incoming datagrams among shards, so that a producer scales across
+ * cores without a forwarder in front of it. Replies are sent from the same local address.
+ * Since the shard of a datagram is chosen by the kernel, each shard must be able to serve any
+ * request independently.
+ *
+ * @code
+ * UdpShardedListener listener(4);
+ * listener.begin(6363, true);
+ * listener.run([&](Face& face, size_t) {
+ *   return std::unique_ptr<PingServer>(new PingServer(prefix, face));
+ * }, stop);
+ * @endcode
+ */
+class UdpShardedListener
+{
+public:
+  /**
+   * @brief Constructor.
+   * @param nShards number of shards.
+   * @param bufLen buffer length of each transport, typically MTU.
+   */
+  explicit UdpShardedListener(size_t nShards,
+                              size_t bufLen = UdpUnicastTransport::DEFAULT_BUFLEN)
+  {
+    for (size_t i = 0; i < nShards; ++i) {
+      m_shards.emplace_back(new Shard(bufLen));
+    }
+  }
+
+  /** @brief Return number of shards. */
+  size_t size() const
+  {
+    return m_shards.size();
+  }
+
+  UdpUnicastTransport& getTransport(size_t i)
+  {
+    return m_shards[i]->transport;
+  }
+
+  Face& getFace(size_t i)
+  {
+    return m_shards[i]->face;
+  }
+
+  /**
+   * @brief Start listening on given local address.
+   * @param steerByCpu if true, a datagram received on CPU c is delivered to shard c % size(),
+   *                   and run() pins the thread of shard i to CPU i. Otherwise, datagrams are
+   *                   distributed by flow hash.
+   */
+  bool begin(const sockaddr_in* laddr, bool steerByCpu = false)
+  {
+    for (size_t i = 0; i < m_shards.size(); ++i) {
+      if (!m_shards[i]->transport.beginListenShard(laddr, steerByCpu ? static_cast<int>(i) : -1)) {
+        end();
+        return false;
+      }
+    }
+    if (steerByCpu && !m_shards.empty() && !m_shards[0]->transport.attachCpuSteering(size())) {
+      end();
+      return false;
+    }
+    m_steerByCpu = steerByCpu;
+    return true;
+  }
+
+  /** @brief Start listening on given local port. */
+  bool begin(uint16_t localPort = 6363, bool steerByCpu = false)
+  {
+    sockaddr_in laddr = {};
+    laddr.sin_family = AF_INET;
+    laddr.sin_addr.s_addr = INADDR_ANY;
+    laddr.sin_port = htons(localPort);
+    return begin(&laddr, steerByCpu);
+  }
+
+  /** @brief Stop listening. */
+  bool end()
+  {
+    bool ok = true;
+    for (auto& shard : m_shards) {
+      ok = shard->transport.end() && ok;
+    }
+    return ok;
+  }
+
+  /**
+   * @brief Run every shard in its own thread, until @p stop becomes true.
+   * @tparam Init `T (*)(Face& face, size_t shard)`, invoked in the shard thread. Its return
+   *              value is kept alive while the shard runs, such as `std::unique_ptr` of packet
+   *              handlers attached to the face.
+   * @param pollTimeout how long to block waiting for datagrams between loop() invocations,
+   *                    in milliseconds. This also limits how often PacketHandler::loop() runs.
+   *
+   * This blocks until all threads have exited.
+   */
+  template<typename Init>
+  void run(const Init& init, const std::atomic_bool& stop, int pollTimeout = 1)
+  {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < m_shards.size(); ++i) {
+      threads.emplace_back([=, &init, &stop] {
+        if (m_steerByCpu) {
+          pinCpu(i);
+        }
+        Shard& shard = *m_shards[i];
+        auto ctx = init(shard.face, i);
+        while (!stop) {
+          shard.transport.waitRx(pollTimeout);
+          shard.face.loop();
+        }
+        (void)ctx;
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+private:
+  static void pinCpu(size_t cpu)
+  {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  }
+
+  struct Shard
+  {
+    explicit Shard(size_t bufLen)
+      : transport(bufLen)
+      , face(transport)
+    {}
+
+    UdpUnicastTransport transport;
+    Face face;
+  };
+
+private:
+  std::vector<std::unique_ptr<Shard>> m_shards;
+  bool m_steerByCpu = false;
+};
+
+} // namespace port_transport_socket
+
+using UdpShardedListener = port_transport_socket::UdpShardedListener;
+
+} // namespace ndnph
+
+#endif // NDNPH_PORT_TRANSPORT_SOCKET_UDP_SHARDED_HPP
@@ -2,25 +2,62 @@
 #define NDNPH_PORT_TRANSPORT_SOCKET_UDP_UNICAST_HPP
 
 #include "../../../face/transport-rxqueue.hpp"
+#include "../../../face/transport-txqueue.hpp"
 
 #include <arpa/inet.h>
 #include <cinttypes>
+#include <linux/filter.h>
 #include <netinet/in.h>
+#include <netinet/udp.h>
+#include <poll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
+#ifndef NDNPH_SOCKET_RXBURST
+/**
+ * @brief Maximum number of packets received by UdpUnicastTransport in one recvmmsg() syscall.
+ *
+ * This is further capped by NDNPH_TRANSPORT_RXQUEUELEN.
+ */
+#define NDNPH_SOCKET_RXBURST NDNPH_TRANSPORT_RXQUEUELEN
+#endif
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+#ifndef SO_INCOMING_CPU
+#define SO_INCOMING_CPU 49
+#endif
+#ifndef SO_ATTACH_REUSEPORT_CBPF
+#define SO_ATTACH_REUSEPORT_CBPF 51
+#endif
+
 namespace ndnph {
 namespace port_transport_socket {
 
-/** @brief A transport that communicates over IPv4 unicast UDP tunnel. */
+/**
+ * @brief A transport that communicates over IPv4 unicast UDP tunnel.
+ *
+ * Incoming packets are received in bursts with recvmmsg(), see NDNPH_SOCKET_RXBURST.
+ * If TX batching is enabled, deferred packets are transmitted with one sendmmsg() syscall.
+ *
+ * On Linux, UDP generic segmentation offload (GSO) and generic receive offload (GRO) can be
+ * enabled to reduce per-packet kernel cost during bulk transfer, such as fragments produced by
+ * lp::Fragmenter or consecutive segments served by a producer.
+ */
 class UdpUnicastTransport
   : public virtual Transport
   , public transport::DynamicRxQueueMixin
+  , public transport::TxQueueMixin
 {
 public:
-  explicit UdpUnicastTransport(size_t bufLen = DEFAULT_BUFLEN)
-    : DynamicRxQueueMixin(bufLen)
+  explicit UdpUnicastTransport(size_t bufLen = DEFAULT_BUFLEN, size_t rxRoom = 0)
+    : DynamicRxQueueMixin(bufLen, rxRoom)
   {}
 
   /** @brief Start listening on given local address. */
@@ -39,6 +76,48 @@ public:
     return beginListen(&laddr);
   }
 
+  /**
+   * @brief Start listening on given local address, as a member of a SO_REUSEPORT group.
+   * @param incomingCpu if non-negative, set SO_INCOMING_CPU socket option to this CPU.
+   *
+   * Several transports, typically one per thread, may listen on the same address. The kernel
+   * distributes incoming datagrams among them, by flow hash or as steered by
+   * attachCpuSteering().
+   */
+  bool beginListenShard(const sockaddr_in* laddr, int incomingCpu = -1)
+  {
+    return (createSocket() && setReusePort(incomingCpu) && bindSocket(laddr)) ||
+           closeSocketOnError();
+  }
+
+  /**
+   * @brief Steer incoming datagrams within the SO_REUSEPORT group by receiving CPU.
+   * @pre this transport has been started with beginListenShard().
+   * @param nShards number of transports in the group.
+   *
+   * A datagram received on CPU c is delivered to the (c % nShards)-th transport, in the order
+   * they were started.
+   */
+  bool attachCpuSteering(uint32_t nShards)
+  {
+    sock_filter code[] = {
+      { BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU) },
+      { BPF_ALU | BPF_MOD | BPF_K, 0, 0, nShards },
+      { BPF_RET | BPF_A, 0, 0, 0 },
+    };
+    sock_fprog prog = {};
+    prog.len = sizeof(code) / sizeof(code[0]);
+    prog.filter = code;
+    if (nShards == 0 ||
+        setsockopt(m_fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) < 0) {
+#ifdef NDNPH_SOCKET_DEBUG
+      perror("UdpUnicastTransport setsockopt(SO_ATTACH_REUSEPORT_CBPF)");
+#endif
+      return false;
+    }
+    return true;
+  }
+
   /** @brief Connect to given remote address. */
   bool beginTunnel(const sockaddr_in* raddr)
   {
@@ -70,9 +149,69 @@ public:
     }
     int ok = close(m_fd);
     m_fd = -1;
+    m_gso = false;
+    disableGro();
     return ok == 0;
   }
 
+  /**
+   * @brief Wait until incoming datagrams may be available.
+   * @param timeout timeout in milliseconds.
+   * @return whether incoming datagrams may be available.
+   *
+   * This allows a dedicated thread to block between loop() invocations instead of busy polling.
+   */
+  bool waitRx(int timeout)
+  {
+    if (m_groPos != m_groEnd) {
+      return true;
+    }
+    pollfd pfd = {};
+    pfd.fd = m_fd;
+    pfd.events = POLLIN;
+    return poll(&pfd, 1, timeout) > 0;
+  }
+
+  /**
+   * @brief Enable UDP GSO on transmission.
+   * @pre socket is open.
+   * @return whether the kernel supports UDP GSO.
+   *
+   * This takes effect when TX batching is enabled via enableTxBatch(). In each burst, consecutive
+   * packets to the same endpoint, of equal length except that the last may be shorter, are
+   * passed to the kernel as one message, which is segmented into separate datagrams.
+   */
+  bool enableGso()
+  {
+    int gsoSize = 0;
+    socklen_t len = sizeof(gsoSize);
+    m_gso = m_fd >= 0 && getsockopt(m_fd, SOL_UDP, UDP_SEGMENT, &gsoSize, &len) == 0;
+    return m_gso;
+  }
+
+  /**
+   * @brief Enable UDP GRO on reception.
+   * @pre socket is open.
+   * @return whether success.
+   *
+   * The kernel may coalesce consecutive datagrams of equal length into one buffer. They are split
+   * and copied into RX queue buffers, and then delivered as separate packets. This disables
+   * recvmmsg() bursts, because each coalesced buffer may contain many packets.
+   */
+  bool enableGro()
+  {
+    const int yes = 1;
+    if (m_fd < 0 || setsockopt(m_fd, SOL_UDP, UDP_GRO, &yes, sizeof(yes)) < 0) {
+#ifdef NDNPH_SOCKET_DEBUG
+      perror("UdpUnicastTransport setsockopt(UDP_GRO)");
+#endif
+      return false;
+    }
+    m_groBuf.reset(new uint8_t[GroBufLen]);
+    m_groPos = m_groEnd = m_groBuf.get();
+    return true;
+  }
+
 private:
   bool doIsUp() const final
   {
@@ -80,32 +219,122 @@ private:
   }
 
   void doLoop() final
+  {
+    if (m_groBuf != nullptr) {
+      receiveGro();
+      loopRxQueue();
+      return;
+    }
+
+    static constexpr size_t BurstSize = NDNPH_SOCKET_RXBURST < NDNPH_TRANSPORT_RXQUEUELEN
+                                          ? NDNPH_SOCKET_RXBURST
+                                          : NDNPH_TRANSPORT_RXQUEUELEN;
+    while (receivingBurst(BurstSize, [this](RxBuffer* bufs, size_t count) {
+             return receiveBurst(bufs, count);
+           }) == BurstSize) {
+    }
+
+    loopRxQueue();
+  }
+
+  size_t receiveBurst(RxBuffer* bufs, size_t count)
+  {
+    mmsghdr msgs[NDNPH_TRANSPORT_RXQUEUELEN] = {};
+    iovec iov[NDNPH_TRANSPORT_RXQUEUELEN];
+    sockaddr_in raddrs[NDNPH_TRANSPORT_RXQUEUELEN];
+    for (size_t i = 0; i < count; ++i) {
+      iov[i].iov_base = bufs[i].buf;
+      iov[i].iov_len = bufs[i].bufLen;
+      msgs[i].msg_hdr.msg_iov = &iov[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+      msgs[i].msg_hdr.msg_name = &raddrs[i];
+      msgs[i].msg_hdr.msg_namelen = sizeof(raddrs[i]);
+    }
+
+    int res = recvmmsg(m_fd, msgs, count, 0, nullptr);
+    if (res < 0) {
+      clearSocketError();
+      return 0;
+    }
+    for (int i = 0; i < res; ++i) {
+      bufs[i].pktLen = msgs[i].msg_len;
+      bufs[i].endpointId =
+        (static_cast<uint64_t>(raddrs[i].sin_port) << 32) | raddrs[i].sin_addr.s_addr;
+    }
+    return res;
+  }
+
+  void receiveGro()
   {
     while (auto r = receiving()) {
-      sockaddr_in raddr = {};
-      socklen_t raddrLen = sizeof(raddr);
-      ssize_t pktLen =
-        recvfrom(m_fd, r.buf(), r.bufLen(), 0, reinterpret_cast<sockaddr*>(&raddr), &raddrLen);
-      if (pktLen < 0) {
-        clearSocketError();
+      if (m_groPos == m_groEnd && !readGro()) {
         break;
       }
-      uint64_t endpointId = (static_cast<uint64_t>(raddr.sin_port) << 32) | raddr.sin_addr.s_addr;
-      r(pktLen, endpointId);
+      size_t pktLen = std::min<size_t>(m_groSegLen, m_groEnd - m_groPos);
+      const uint8_t* pkt = m_groPos;
+      m_groPos += pktLen;
+      if (pktLen > r.bufLen()) {
+        continue;
+      }
+      std::copy_n(pkt, pktLen, r.buf());
+      r(pktLen, m_groEndpointId);
     }
+  }
 
-    loopRxQueue();
+  /** @brief Receive a possibly coalesced buffer into m_groBuf. */
+  bool readGro()
+  {
+    iovec iov;
+    iov.iov_base = m_groBuf.get();
+    iov.iov_len = GroBufLen;
+    sockaddr_in raddr = {};
+    CmsgBuf cmsgBuf;
+    msghdr msg = {};
+    msg.msg_name = &raddr;
+    msg.msg_namelen = sizeof(raddr);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = cmsgBuf.buf;
+    msg.msg_controllen = sizeof(cmsgBuf.buf);
+
+    ssize_t len = recvmsg(m_fd, &msg, 0);
+    if (len < 0) {
+      clearSocketError();
+      return false;
+    }
+    m_groSegLen = len;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+        int segLen = 0;
+        std::memcpy(&segLen, CMSG_DATA(cmsg), sizeof(segLen));
+        if (segLen > 0) {
+          m_groSegLen = segLen;
+        }
+      }
+    }
+    m_groPos = m_groBuf.get();
+    m_groEnd = m_groPos + len;
+    m_groEndpointId = (static_cast<uint64_t>(raddr.sin_port) << 32) | raddr.sin_addr.s_addr;
+    return true;
+  }
+
+  void disableGro()
+  {
+    m_groBuf.reset();
+    m_groPos = m_groEnd = nullptr;
   }
 
   bool doSend(const uint8_t* pkt, size_t pktLen, uint64_t endpointId) final
   {
+    if (enqueueTx(pkt, pktLen, endpointId)) {
+      return true;
+    }
+
     const sockaddr* raddr = nullptr;
     socklen_t raddrLen = 0;
     sockaddr_in raddrEndpoint;
     if (endpointId != 0) {
-      raddrEndpoint.sin_family = AF_INET;
-      raddrEndpoint.sin_addr.s_addr = endpointId;
-      raddrEndpoint.sin_port = endpointId >> 32;
+      toSockaddr(endpointId, raddrEndpoint);
       raddr = reinterpret_cast<const sockaddr*>(&raddrEndpoint);
       raddrLen = sizeof(raddrEndpoint);
     }
@@ -117,6 +346,126 @@ private:
     return false;
   }
 
+  bool doCanSendv() const final
+  {
+    return true;
+  }
+
+  bool doSendv(const tlv::Value* segs, size_t count, uint64_t endpointId) final
+  {
+    if (enqueueTx(segs, count, endpointId)) {
+      return true;
+    }
+
+    iovec iov[EncoderGather::MaxSegments];
+    if (count > EncoderGather::MaxSegments) {
+      return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      iov[i].iov_base = const_cast<uint8_t*>(segs[i].begin());
+      iov[i].iov_len = segs[i].size();
+    }
+
+    msghdr msg = {};
+    sockaddr_in raddrEndpoint;
+    if (endpointId != 0) {
+      toSockaddr(endpointId, raddrEndpoint);
+      msg.msg_name = &raddrEndpoint;
+      msg.msg_namelen = sizeof(raddrEndpoint);
+    }
+    msg.msg_iov = iov;
+    msg.msg_iovlen = count;
+    ssize_t sentLen = sendmsg(m_fd, &msg, 0);
+    if (sentLen >= 0) {
+      return true;
+    }
+    clearSocketError();
+    return false;
+  }
+
+  size_t doSendBurst(const transport::TxPacket* pkts, size_t count) final
+  {
+    size_t nSent = 0;
+    while (nSent < count) {
+      static constexpr size_t BurstSize = 64;
+      mmsghdr msgs[BurstSize] = {};
+      iovec iov[BurstSize];
+      sockaddr_in raddrs[BurstSize];
+      CmsgBuf cmsgBufs[BurstSize];
+      size_t nSegs[BurstSize];
+      size_t nMsgs = 0;
+      for (size_t i = nSent, nIov = 0; i < count && nIov < BurstSize; ++nMsgs) {
+        const transport::TxPacket& p = pkts[i];
+        size_t n = m_gso ? countGsoSegments(&p, std::min(count - i, BurstSize - nIov)) : 1;
+        msghdr& hdr = msgs[nMsgs].msg_hdr;
+        hdr.msg_iov = &iov[nIov];
+        hdr.msg_iovlen = n;
+        for (size_t j = 0; j < n; ++j, ++nIov) {
+          iov[nIov].iov_base = const_cast<uint8_t*>(pkts[i + j].pkt);
+          iov[nIov].iov_len = pkts[i + j].pktLen;
+        }
+        if (p.endpointId != 0) {
+          toSockaddr(p.endpointId, raddrs[nMsgs]);
+          hdr.msg_name = &raddrs[nMsgs];
+          hdr.msg_namelen = sizeof(raddrs[nMsgs]);
+        }
+        if (n > 1) {
+          hdr.msg_control = cmsgBufs[nMsgs].buf;
+          hdr.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+          cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+          cmsg->cmsg_level = SOL_UDP;
+          cmsg->cmsg_type = UDP_SEGMENT;
+          cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+          uint16_t gsoSize = p.pktLen;
+          std::memcpy(CMSG_DATA(cmsg), &gsoSize, sizeof(gsoSize));
+        }
+        nSegs[nMsgs] = n;
+        i += n;
+      }
+
+      int res = sendmmsg(m_fd, msgs, nMsgs, 0);
+      if (res <= 0) {
+        clearSocketError();
+        break;
+      }
+      for (int i = 0; i < res; ++i) {
+        nSent += nSegs[i];
+      }
+    }
+    return nSent;
+  }
+
+  /**
+   * @brief Count packets that can be sent as one GSO message.
+   * @param pkts first packet determines endpoint and segment size.
+   * @param max maximum number of packets.
+   */
+  static size_t countGsoSegments(const transport::TxPacket* pkts, size_t max)
+  {
+    size_t segLen = pkts[0].pktLen, total = segLen, n = 1;
+    if (segLen == 0 || segLen > UINT16_MAX) {
+      return 1;
+    }
+    max = std::min(max, static_cast<size_t>(GsoMaxSegments));
+    for (; n < max; ++n) {
+      const transport::TxPacket& p = pkts[n];
+      if (p.endpointId != pkts[0].endpointId || pkts[n - 1].pktLen != segLen || p.pktLen == 0 ||
+          p.pktLen > segLen || total + p.pktLen > GsoMaxBytes) {
+        break;
+      }
+      total += p.pktLen;
+    }
+    return n;
+  }
+
+  static void toSockaddr(uint64_t endpointId, sockaddr_in& raddr)
+  {
+    raddr = {};
+    raddr.sin_family = AF_INET;
+    raddr.sin_addr.s_addr = endpointId;
+    raddr.sin_port = endpointId >> 32;
+  }
+
 private:
   bool createSocket()
   {
@@ -138,6 +487,25 @@ private:
     return true;
   }
 
+  bool setReusePort(int incomingCpu)
+  {
+    const int yes = 1;
+    if (setsockopt(m_fd, SOL_SOCKET, SO_REUSEPORT, &yes, sizeof(yes)) < 0) {
+#ifdef NDNPH_SOCKET_DEBUG
+      perror("UdpUnicastTransport setsockopt(SO_REUSEPORT)");
+#endif
+      return false;
+    }
+    if (incomingCpu >= 0 &&
+        setsockopt(m_fd, SOL_SOCKET, SO_INCOMING_CPU, &incomingCpu, sizeof(incomingCpu)) < 0) {
+#ifdef NDNPH_SOCKET_DEBUG
+      perror("UdpUnicastTransport setsockopt(SO_INCOMING_CPU)");
+#endif
+      return false;
+    }
+    return true;
+  }
+
   bool bindSocket(const sockaddr_in* laddr)
   {
     if (bind(m_fd, reinterpret_cast<const sockaddr*>(laddr), sizeof(*laddr)) < 0) {
@@ -192,8 +560,26 @@ private:
   }
 
 private:
+  /** @brief Maximum segments per GSO message, UDP_MAX_SEGMENTS in Linux. */
+  static constexpr size_t GsoMaxSegments = 64;
+  /** @brief Maximum UDP payload in GSO message or GRO buffer. */
+  static constexpr size_t GsoMaxBytes = 65507;
+  static constexpr size_t GroBufLen = 65535;
+
+  union CmsgBuf
+  {
+    char buf[CMSG_SPACE(sizeof(int))];
+    cmsghdr align;
+  };
+
   int m_fd = -1;
   ssize_t m_mtu = -1;
+  bool m_gso = false;
+  std::unique_ptr<uint8_t[]> m_groBuf;
+  const uint8_t* m_groPos = nullptr;
+  const uint8_t* m_groEnd = nullptr;
+  size_t m_groSegLen = 0;
+  uint64_t m_groEndpointId = 0;
 };
 
 } // namespace port_transport_socket
@@ -54,20 +54,15 @@ public:
       d = Tlv{};
       return true;
     }
-    int sizeofT = tlv::readVarNum(input, end - input, d.type);
-    if (sizeofT == 0) {
-      return false;
-    }
-    const uint8_t* posL = input + sizeofT;
     uint32_t length;
-    int sizeofL = tlv::readVarNum(posL, end - posL, length);
-    if (sizeofL == 0) {
+    int sizeofTL = tlv::readTypeLength(input, end - input, d.type, length);
+    if (sizeofTL == 0) {
       return false;
     }
     d.length = length;
-    d.value = posL + sizeofL;
+    d.value = input + sizeofTL;
     d.tlv = input;
-    d.size = sizeofT + sizeofL + length;
+    d.size = sizeofTL + length;
     return end - d.value >= static_cast<ssize_t>(length);
   }
 
@@ -6,6 +6,41 @@
 
 namespace ndnph {
 
+class Encoder;
+
+/**
+ * @brief Scatter-gather list of Encoder output.
+ * @sa Encoder::setGather
+ */
+class EncoderGather
+{
+public:
+  enum
+  {
+    MaxRefs = 4,                   ///< maximum number of referenced values
+    MaxSegments = 2 * MaxRefs + 1, ///< maximum number of segments in gathered output
+  };
+
+  /** @param minSize minimum size of a value to be referenced rather than copied. */
+  explicit EncoderGather(size_t minSize = 128)
+    : m_minSize(minSize)
+  {}
+
+private:
+  struct Ref
+  {
+    uint8_t* room;
+    const uint8_t* value;
+    size_t size;
+  };
+
+  std::array<Ref, MaxRefs> m_refs;
+  size_t m_nRefs = 0;
+  size_t m_minSize = 0;
+
+  friend Encoder;
+};
+
 /** @brief TLV encoder that accepts items in reverse order. */
 class Encoder
 {
@@ -50,6 +85,12 @@ public:
     return m_pos == nullptr ? 0 : m_end - m_pos;
   }
 
+  /** @brief Compute remaining room for prepending. */
+  size_t available() const
+  {
+    return m_pos == nullptr ? 0 : m_pos - m_buf;
+  }
+
   /**
    * @brief Release unused space to the Region.
    *
@@ -77,12 +118,106 @@ public:
     }
     m_region->free(m_buf, m_end - m_buf);
     m_buf = m_pos = m_end = nullptr;
+    if (m_gather != nullptr) {
+      m_gather->m_nRefs = 0;
+    }
   }
 
   /** @brief Reset front to given position. */
   void resetFront(uint8_t* pos)
   {
     m_pos = pos;
+    if (m_gather != nullptr) {
+      while (m_gather->m_nRefs > 0 && m_gather->m_refs[m_gather->m_nRefs - 1].room < pos) {
+        --m_gather->m_nRefs;
+      }
+    }
+  }
+
+  /**
+   * @brief Enable or disable scatter-gather mode.
+   * @param gather scatter-gather list, or nullptr to disable. It must outlive the output.
+   *
+   * In scatter-gather mode, large values passed to prependRef() are referenced rather than
+   * copied: their room is reserved in the output but left unwritten. Such output must be read
+   * with gather(), or made contiguous with fillRefs().
+   */
+  void setGather(EncoderGather* gather)
+  {
+    m_gather = gather;
+    if (m_gather != nullptr) {
+      m_gather->m_nRefs = 0;
+    }
+  }
+
+  /**
+   * @brief Prepend a value that may be referenced in scatter-gather mode.
+   * @return whether success.
+   */
+  bool prependRef(const uint8_t* value, size_t size)
+  {
+    uint8_t* room = prependRoom(size);
+    if (room == nullptr) {
+      return false;
+    }
+    if (m_gather != nullptr && size >= m_gather->m_minSize &&
+        m_gather->m_nRefs < EncoderGather::MaxRefs) {
+      m_gather->m_refs[m_gather->m_nRefs++] = EncoderGather::Ref{ room, value, size };
+    } else {
+      std::copy_n(value, size, room);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Iterate over segments of an output range in scatter-gather mode.
+   * @tparam F `void (*)(const uint8_t* buf, size_t size)`
+   * @param first,last a range within output, which must not split a referenced value.
+   *
+   * Segments are either part of the output buffer or referenced values.
+   * There are at most EncoderGather::MaxSegments segments.
+   */
+  template<typename F>
+  void gather(const uint8_t* first, const uint8_t* last, const F& f) const
+  {
+    const uint8_t* pos = first;
+    // references are recorded in decreasing address order
+    for (size_t i = m_gather == nullptr ? 0 : m_gather->m_nRefs; i > 0; --i) {
+      const EncoderGather::Ref& ref = m_gather->m_refs[i - 1];
+      if (ref.room < first || ref.room >= last) {
+        continue;
+      }
+      if (ref.room > pos) {
+        f(pos, ref.room - pos);
+      }
+      f(ref.value, ref.size);
+      pos = ref.room + ref.size;
+    }
+    if (last > pos) {
+      f(pos, last - pos);
+    }
+  }
+
+  /** @brief Iterate over segments of output in scatter-gather mode. */
+  template<typename F>
+  void gather(const F& f) const
+  {
+    if (m_pos != nullptr) {
+      gather(m_pos, m_end, f);
+    }
+  }
+
+  /** @brief Copy referenced values into output, making it contiguous. */
+  void fillRefs()
+  {
+    if (m_gather == nullptr) {
+      return;
+    }
+    for (size_t i = 0; i < m_gather->m_nRefs; ++i) {
+      const EncoderGather::Ref& ref = m_gather->m_refs[i];
+      std::copy_n(ref.value, ref.size, ref.room);
+    }
+    m_gather->m_nRefs = 0;
   }
 
   /**
@@ -106,14 +241,11 @@ public:
    */
   bool prependTypeLength(uint32_t type, size_t length)
   {
-    size_t sizeT = tlv::sizeofVarNum(type);
-    size_t sizeL = tlv::sizeofVarNum(length);
-    uint8_t* room = prependRoom(sizeT + sizeL);
+    uint8_t* room = prependRoom(tlv::sizeofTypeLength(type, length));
     if (room == nullptr) {
       return false;
     }
-    tlv::writeVarNum(room, type);
-    tlv::writeVarNum(room + sizeT, length);
+    tlv::writeTypeLength(room, type, length);
     return true;
   }
 
@@ -204,6 +336,7 @@ private:
 
 private:
   Region* m_region = nullptr;
+  EncoderGather* m_gather = nullptr;
   uint8_t* m_buf = nullptr;
   uint8_t* m_pos = nullptr;
   uint8_t* m_end = nullptr;
@@ -103,6 +103,46 @@ private:
   ValueType* m_value;
 };
 
+/**
+ * @brief Dispatch table of element definitions.
+ *
+ * Per-definition properties are laid out in constant arrays, so that an incoming TLV-TYPE is
+ * looked up by index rather than through a chain of comparisons against each definition.
+ * Each array has a trailing sentinel so that an empty pack still yields a valid array.
+ */
+template<typename... E>
+struct EvdTable
+{
+  static constexpr size_t size = sizeof...(E);
+  static constexpr uint32_t types[sizeof...(E) + 1] = { E::TT::value..., 0 };
+  static constexpr int orders[sizeof...(E) + 1] = { E::Order::value..., 0 };
+  static constexpr bool repeatable[sizeof...(E) + 1] = { E::Repeatable::value..., false };
+
+  /** @brief Find index of definition with TLV-TYPE, or size if not found. */
+  static size_t find(uint32_t type)
+  {
+    size_t i = 0;
+    for (; i < size && types[i] != type; ++i) {
+    }
+    return i;
+  }
+
+  /** @brief Determine whether two definitions have the same TLV-TYPE. */
+  static constexpr bool hasDuplicate(size_t i = 0, size_t j = 1)
+  {
+    return i + 1 >= size ? false
+                         : j >= size ? hasDuplicate(i + 1, i + 2)
+                                     : types[i] == types[j] || hasDuplicate(i, j + 1);
+  }
+};
+
+template<typename... E>
+constexpr uint32_t EvdTable<E...>::types[];
+template<typename... E>
+constexpr int EvdTable<E...>::orders[];
+template<typename... E>
+constexpr bool EvdTable<E...>::repeatable[];
+
 } // namespace detail
 
 /** @brief TLV decoder that understands Packet Format v0.3 evolvability guidelines. */
@@ -186,17 +226,49 @@ public:
     return decodeValueEx(input.vd(), unknownCb, isCritical, defs...);
   }
 
-  /** @brief Decode input TLV-VALUE with a sequence of element definitions. */
+  /**
+   * @brief Decode input TLV-VALUE with a sequence of element definitions.
+   *
+   * Element definitions must have distinct TLV-TYPE numbers. When elements arrive in the order
+   * of definitions, which is the common case, each lookup is a single comparison.
+   */
   template<typename UnknownCallback, typename IsCritical, typename... E>
   static bool decodeValueEx(const Decoder& input, const UnknownCallback& unknownCb,
                             const IsCritical& isCritical, const E&... defs)
   {
+    using Table = detail::EvdTable<E...>;
+    static_assert(!Table::hasDuplicate(), "duplicate TLV-TYPE in element definitions");
+
     int currentOrder = 0;
+    size_t next = 0;
     for (const auto& d : input) {
-      bool ok = decodeElement<AUTO_ORDER_SKIP>(d, currentOrder, unknownCb, isCritical, defs...);
-      if (!ok) {
+      size_t i = next;
+      if (Table::types[i] != d.type || i == Table::size) {
+        i = Table::find(d.type);
+      }
+      if (i == Table::size) {
+        if (!unknownCb(d, currentOrder) && !handleUnrecognized(d, isCritical)) {
+          return false;
+        }
+        continue;
+      }
+
+      int defOrder = Table::orders[i] == 0 ? AUTO_ORDER_SKIP * static_cast<int>(i + 1)
+                                           : Table::orders[i];
+      if (currentOrder > defOrder) {
+        if (!handleUnrecognized(d, isCritical)) { // out of order
+          return false;
+        }
+        continue;
+      }
+      if (currentOrder == defOrder && !Table::repeatable[i]) {
+        return false; // cannot repeat
+      }
+      currentOrder = defOrder;
+      if (!invokeDef<0>(i, d, defs...)) {
         return false;
       }
+      next = Table::repeatable[i] ? i : i + 1;
     }
     return true;
   }
@@ -257,39 +329,19 @@ private:
     AUTO_ORDER_SKIP = 100,
   };
 
-  template<int autoOrder, typename UnknownCallback, typename IsCritical, typename First,
-           typename... E>
-  static bool decodeElement(const Decoder::Tlv& d, int& currentOrder,
-                            const UnknownCallback& unknownCb, const IsCritical& isCritical,
-                            const First& first, const E&... defs)
+  template<size_t index, typename First, typename... E>
+  static bool invokeDef(size_t i, const Decoder::Tlv& d, const First& first, const E&... defs)
   {
-    if (d.type == First::TT::value) {
-      return useDef<autoOrder>(d, currentOrder, isCritical, first);
+    if (i == index) {
+      return first(d);
     }
-    return decodeElement<autoOrder + AUTO_ORDER_SKIP>(d, currentOrder, unknownCb, isCritical,
-                                                      defs...);
-  }
-
-  template<int autoOrder, typename UnknownCallback, typename IsCritical>
-  static bool decodeElement(const Decoder::Tlv& d, int& currentOrder,
-                            const UnknownCallback& unknownCb, const IsCritical& isCritical)
-  {
-    return unknownCb(d, currentOrder) || handleUnrecognized(d, isCritical);
+    return invokeDef<index + 1>(i, d, defs...);
   }
 
-  template<int autoOrder, typename IsCritical, typename E>
-  static bool useDef(const Decoder::Tlv& d, int& currentOrder, const IsCritical& isCritical,
-                     const E& def)
+  template<size_t index>
+  static bool invokeDef(size_t, const Decoder::Tlv&)
   {
-    int defOrder = E::Order::value == 0 ? autoOrder : E::Order::value;
-    if (currentOrder > defOrder) {
-      return handleUnrecognized(d, isCritical); // out of order
-    }
-    if (currentOrder == defOrder && !E::Repeatable::value) {
-      return false; // cannot repeat
-    }
-    currentOrder = defOrder;
-    return def(d);
+    return false;
   }
 
   template<typename IsCritical>
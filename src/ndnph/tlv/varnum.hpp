@@ -13,6 +13,20 @@ sizeofVarNum(uint32_t n)
   return n < 0xFD ? 1 : n <= 0xFFFF ? 3 : 5;
 }
 
+/** @brief Compute size of TLV-TYPE and TLV-LENGTH. */
+constexpr size_t
+sizeofTypeLength(uint32_t type, size_t length)
+{
+  return sizeofVarNum(type) + sizeofVarNum(length);
+}
+
+/** @brief Compute size of a TLV element with given TLV-LENGTH. */
+constexpr size_t
+sizeofTlv(uint32_t type, size_t length)
+{
+  return sizeofTypeLength(type, length) + length;
+}
+
 /** @brief Write VAR-NUMBER. */
 inline void
 writeVarNum(uint8_t* room, uint32_t n)
@@ -32,6 +46,20 @@ writeVarNum(uint8_t* room, uint32_t n)
   }
 }
 
+/**
+ * @brief Write TLV-TYPE and TLV-LENGTH.
+ * @param room buffer with at least sizeofTypeLength(type, length) octets.
+ * @return written size.
+ */
+inline size_t
+writeTypeLength(uint8_t* room, uint32_t type, size_t length)
+{
+  writeVarNum(room, type);
+  size_t sizeT = sizeofVarNum(type);
+  writeVarNum(room + sizeT, length);
+  return sizeT + sizeofVarNum(length);
+}
+
 /**
  * @brief Read VAR-NUMBER.
  * @return consumed bytes, or 0 upon error.
@@ -54,6 +82,31 @@ readVarNum(const uint8_t* input, size_t size, uint32_t& n)
   return 0;
 }
 
+/**
+ * @brief Read TLV-TYPE and TLV-LENGTH.
+ * @return consumed bytes, or 0 upon error.
+ *
+ * This has a fast path for the common case where both fields are one octet.
+ */
+inline int
+readTypeLength(const uint8_t* input, size_t size, uint32_t& type, uint32_t& length)
+{
+  if (size >= 2 && input[0] < 0xFD && input[1] < 0xFD) {
+    type = input[0];
+    length = input[1];
+    return 2;
+  }
+  int sizeofT = readVarNum(input, size, type);
+  if (sizeofT == 0) {
+    return 0;
+  }
+  int sizeofL = readVarNum(input + sizeofT, size - sizeofT, length);
+  if (sizeofL == 0) {
+    return 0;
+  }
+  return sizeofT + sizeofL;
+}
+
 } // namespace tlv
 } // namespace ndnph
 
@@ -0,0 +1,141 @@
+#ifndef NDNPH_TEST_BENCH_COMMON_HPP
+#define NDNPH_TEST_BENCH_COMMON_HPP
+
+#include "ndnph/core/region.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace ndnph {
+namespace bench {
+
+/** @brief Prevent the compiler from optimizing away a computed value. */
+template<typename T>
+inline void
+doNotOptimize(const T& value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/** @brief Benchmark result. */
+struct Result
+{
+  uint64_t iterations = 0;
+  double nsPerOp = 0.0;
+  size_t bytesPerOp = 0;
+  const char* skipped = nullptr;
+};
+
+/** @brief Benchmark runner state passed to each benchmark. */
+class State
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit State(Clock::duration minTime)
+    : m_minTime(minTime)
+  {}
+
+  /**
+   * @brief Count usage of another region in bytes per operation.
+   *
+   * This should be invoked before run(), if the operation allocates from a region other than
+   * the one passed to it. The region should be reset by its owner once per operation, such as
+   * a Face region that is reset upon each received packet.
+   */
+  void measureRegion(Region& region)
+  {
+    m_regions.push_back(&region);
+  }
+
+  /**
+   * @brief Measure an operation.
+   * @tparam F `void (*)(Region&)`
+   *
+   * The region is reset before each invocation. Bytes per operation is the size of this region
+   * and regions added via measureRegion() after a single invocation. Iteration count doubles
+   * until total duration reaches minimum time.
+   */
+  template<typename F>
+  void run(const F& f, size_t regionCapacity = 65536)
+  {
+    DynamicRegion region(regionCapacity);
+    f(region); // warm up
+    m_result.bytesPerOp = region.size();
+    for (const Region* r : m_regions) {
+      m_result.bytesPerOp += r->size();
+    }
+
+    for (uint64_t n = 1;; n *= 2) {
+      auto t0 = Clock::now();
+      for (uint64_t i = 0; i < n; ++i) {
+        region.reset();
+        f(region);
+      }
+      auto elapsed = Clock::now() - t0;
+      if (elapsed >= m_minTime || n >= MaxIterations) {
+        m_result.iterations = n;
+        m_result.nsPerOp =
+          std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(n);
+        return;
+      }
+    }
+  }
+
+  /** @brief Mark benchmark as skipped, e.g. when a dependency is unavailable. */
+  void skip(const char* reason)
+  {
+    m_result.skipped = reason;
+  }
+
+  const Result& getResult() const
+  {
+    return m_result;
+  }
+
+private:
+  static constexpr uint64_t MaxIterations = 1 << 30;
+  Clock::duration m_minTime;
+  std::vector<Region*> m_regions;
+  Result m_result;
+};
+
+using Fn = void (*)(State&);
+
+struct Case
+{
+  const char* suite;
+  const char* name;
+  Fn fn;
+};
+
+inline std::vector<Case>&
+getRegistry()
+{
+  static std::vector<Case> registry;
+  return registry;
+}
+
+class Registrar
+{
+public:
+  explicit Registrar(const char* suite, const char* name, Fn fn)
+  {
+    getRegistry().push_back(Case{ suite, name, fn });
+  }
+};
+
+} // namespace bench
+} // namespace ndnph
+
+/** @brief Define a benchmark, similar to gtest TEST(). */
+#define NDNPH_BENCH(suite, name)                                                                   \
+  static void bench_##suite##_##name(::ndnph::bench::State& state);                               \
+  static ::ndnph::bench::Registrar benchRegistrar_##suite##_##name(#suite, #name,                 \
+                                                                   bench_##suite##_##name);       \
+  static void bench_##suite##_##name(::ndnph::bench::State& state)
+
+#endif // NDNPH_TEST_BENCH_COMMON_HPP
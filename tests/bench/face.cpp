@@ -0,0 +1,185 @@
+#include "ndnph/face/bridge-transport.hpp"
+#include "ndnph/face/packet-handler.hpp"
+#include "ndnph/keychain/null.hpp"
+
+#include "bench-common.hpp"
+
+namespace ndnph {
+namespace {
+
+class Producer : public PacketHandler
+{
+public:
+  explicit Producer(Face& face, Region& region, size_t contentLen)
+    : PacketHandler(face)
+    , m_region(region)
+    , m_content(contentLen)
+  {}
+
+private:
+  bool processInterest(Interest interest) final
+  {
+    m_region.reset();
+    Data data = m_region.create<Data>();
+    data.setName(interest.getName());
+    data.setContent(tlv::Value(m_content.data(), m_content.size()));
+    return reply(data.sign(NullKey::get()));
+  }
+
+private:
+  Region& m_region;
+  std::vector<uint8_t> m_content;
+};
+
+class Consumer : public PacketHandler
+{
+public:
+  explicit Consumer(Face& face)
+    : PacketHandler(face)
+  {}
+
+  bool request(Region& region, const Interest& interest)
+  {
+    return send(region, interest);
+  }
+
+private:
+  bool processData(Data) final
+  {
+    ++nData;
+    return true;
+  }
+
+public:
+  uint64_t nData = 0;
+};
+
+template<size_t contentLen>
+void
+roundTrip(bench::State& state)
+{
+  BridgeTransport transportA;
+  BridgeTransport transportB;
+  transportA.begin(transportB);
+  StaticRegion<2048> faceRegionA;
+  StaticRegion<2048> faceRegionB;
+  StaticRegion<2048> producerRegion;
+  Face faceA(faceRegionA, transportA);
+  Face faceB(faceRegionB, transportB);
+  Consumer consumer(faceA);
+  Producer producer(faceB, producerRegion, contentLen);
+  state.measureRegion(faceRegionA);
+  state.measureRegion(faceRegionB);
+  state.measureRegion(producerRegion);
+
+  StaticRegion<256> fixture;
+  Interest interest = fixture.create<Interest>();
+  interest.setName(Name::parse(fixture, "/example/testApp/randomData"));
+
+  state.run([&](Region& region) {
+    consumer.request(region, interest);
+    faceB.loop();
+    faceA.loop();
+  });
+  if (consumer.nData == 0) {
+    state.skip("no Data received");
+  }
+}
+
+NDNPH_BENCH(Face, RoundTrip100)
+{
+  roundTrip<100>(state);
+}
+
+NDNPH_BENCH(Face, RoundTrip1000)
+{
+  roundTrip<1000>(state);
+}
+
+class PrefixSink : public PacketHandler
+{
+public:
+  explicit PrefixSink(Face& face, Name prefix)
+    : PacketHandler(face)
+    , m_prefix(prefix)
+  {
+    face.addPrefix(*this, m_prefix);
+  }
+
+private:
+  bool processInterest(Interest interest) final
+  {
+    if (!m_prefix.isPrefixOf(interest.getName())) {
+      return false;
+    }
+    ++nInterests;
+    return true;
+  }
+
+public:
+  uint64_t nInterests = 0;
+
+private:
+  Name m_prefix;
+};
+
+template<bool indexed, int nProducers>
+void
+dispatch(bench::State& state)
+{
+  BridgeTransport transportA;
+  BridgeTransport transportB;
+  transportA.begin(transportB);
+  StaticRegion<2048> faceRegionB;
+  Face faceA(transportA);
+  Face faceB(faceRegionB, transportB);
+  state.measureRegion(faceRegionB);
+  DynamicRegion indexRegion(131072);
+  if (indexed && !faceB.enablePrefixIndex(indexRegion, nProducers)) {
+    state.skip("enablePrefixIndex failed");
+    return;
+  }
+  Consumer consumer(faceA);
+
+  DynamicRegion fixture(65536);
+  std::vector<std::unique_ptr<PrefixSink>> sinks;
+  for (int i = 0; i < nProducers; ++i) {
+    auto uri = "/example/producer" + std::to_string(i);
+    sinks.emplace_back(new PrefixSink(faceB, Name::parse(fixture, uri.data())));
+  }
+  // addHandler() inserts equal-priority handlers at the head of the chain, so that the first
+  // registered handler is the last one visited in an unindexed dispatch
+  Interest interest = fixture.create<Interest>();
+  interest.setName(Name::parse(fixture, "/example/producer0/data"));
+
+  state.run([&](Region& region) {
+    consumer.request(region, interest);
+    faceB.loop();
+  });
+  if (sinks.front()->nInterests == 0) {
+    state.skip("no Interest dispatched");
+  }
+}
+
+NDNPH_BENCH(Face, DispatchChain64)
+{
+  dispatch<false, 64>(state);
+}
+
+NDNPH_BENCH(Face, DispatchIndex64)
+{
+  dispatch<true, 64>(state);
+}
+
+NDNPH_BENCH(Face, DispatchChain512)
+{
+  dispatch<false, 512>(state);
+}
+
+NDNPH_BENCH(Face, DispatchIndex512)
+{
+  dispatch<true, 512>(state);
+}
+
+} // namespace
+} // namespace ndnph
@@ -0,0 +1,72 @@
+#include "ndnph/keychain/null.hpp"
+#include "ndnph/packet/data.hpp"
+#include "ndnph/packet/lp.hpp"
+
+#include "bench-common.hpp"
+
+namespace ndnph {
+namespace {
+
+class LpFixture
+{
+public:
+  explicit LpFixture()
+    : content(4000)
+  {
+    data = region.create<Data>();
+    data.setName(Name::parse(region, "/example/testApp/randomData"));
+    data.setContent(tlv::Value(content.data(), content.size()));
+  }
+
+public:
+  DynamicRegion region{ 4096 };
+  std::vector<uint8_t> content;
+  Data data;
+};
+
+NDNPH_BENCH(Lp, Fragment)
+{
+  LpFixture f;
+  DynamicRegion fragRegion(8192);
+  lp::Fragmenter frag(fragRegion, 1500);
+  state.run([&](Region& region) {
+    const lp::Fragmenter::Fragment* first = frag.fragment(lp::encode(f.data.sign(NullKey::get())));
+    for (auto fragment = first; fragment != nullptr; fragment = fragment->next) {
+      Encoder encoder(region);
+      encoder.prepend(*fragment);
+      encoder.trim();
+    }
+    bench::doNotOptimize(first);
+  });
+}
+
+NDNPH_BENCH(Lp, Reassemble)
+{
+  LpFixture f;
+  DynamicRegion fragRegion(8192);
+  lp::Fragmenter frag(fragRegion, 1500);
+  std::vector<std::vector<uint8_t>> wires;
+  for (auto fragment = frag.fragment(lp::encode(f.data.sign(NullKey::get())));
+       fragment != nullptr; fragment = fragment->next) {
+    Encoder encoder(f.region);
+    encoder.prepend(*fragment);
+    wires.emplace_back(encoder.begin(), encoder.end());
+    encoder.discard();
+  }
+
+  DynamicRegion reassRegion(8192);
+  lp::Reassembler reass(reassRegion);
+  state.run([&](Region&) {
+    for (const auto& wire : wires) {
+      lp::PacketClassify classify;
+      if (Decoder(wire.data(), wire.size()).decode(classify) &&
+          classify.getType() == lp::PacketClassify::Type::Fragment) {
+        reass.add(classify.getFragment());
+      }
+    }
+    bench::doNotOptimize(reass.reassemble().getType());
+  });
+}
+
+} // namespace
+} // namespace ndnph
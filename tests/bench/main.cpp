@@ -0,0 +1,43 @@
+#include "bench-common.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace ndnph::bench;
+
+/**
+ * Usage: benchmark [FILTER] [MIN-TIME-MS]
+ *
+ * FILTER selects benchmarks whose "suite.name" contains the substring.
+ * MIN-TIME-MS is the minimum measured duration of each benchmark, default 500.
+ */
+int
+main(int argc, char** argv)
+{
+  const char* filter = argc > 1 ? argv[1] : "";
+  int minTimeMs = argc > 2 ? std::atoi(argv[2]) : 500;
+
+  std::vector<Case> cases = getRegistry();
+  std::stable_sort(cases.begin(), cases.end(),
+                   [](const Case& a, const Case& b) { return std::strcmp(a.suite, b.suite) < 0; });
+
+  std::printf("%-32s %12s %12s %10s\n", "benchmark", "iterations", "ns/op", "bytes/op");
+  for (const Case& c : cases) {
+    std::string fullName = std::string(c.suite) + "." + c.name;
+    if (fullName.find(filter) == std::string::npos) {
+      continue;
+    }
+
+    State state{ std::chrono::milliseconds(minTimeMs) };
+    c.fn(state);
+    const Result& result = state.getResult();
+    if (result.skipped != nullptr) {
+      std::printf("%-32s skipped: %s\n", fullName.data(), result.skipped);
+      continue;
+    }
+    std::printf("%-32s %12llu %12.1f %10zu\n", fullName.data(),
+                static_cast<unsigned long long>(result.iterations), result.nsPerOp,
+                result.bytesPerOp);
+  }
+  return 0;
+}
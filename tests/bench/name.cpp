@@ -0,0 +1,45 @@
+#include "ndnph/packet/name.hpp"
+
+#include "bench-common.hpp"
+
+namespace ndnph {
+namespace {
+
+const char* URI = "/example/testApp/randomData/8=version/8=segment";
+
+NDNPH_BENCH(Name, Parse)
+{
+  state.run([](Region& region) { bench::doNotOptimize(Name::parse(region, URI)); });
+}
+
+NDNPH_BENCH(Name, Decode)
+{
+  StaticRegion<256> fixture;
+  Name name = Name::parse(fixture, URI);
+  state.run([&](Region&) { bench::doNotOptimize(Name(name.value(), name.length())); });
+}
+
+NDNPH_BENCH(Name, Compare)
+{
+  StaticRegion<256> fixture;
+  Name a = Name::parse(fixture, URI);
+  Name b = Name::parse(fixture, "/example/testApp/randomData/8=version/8=segmenu");
+  state.run([&](Region&) { bench::doNotOptimize(a.compare(b)); });
+}
+
+NDNPH_BENCH(Name, Slice)
+{
+  StaticRegion<256> fixture;
+  Name name = Name::parse(fixture, URI);
+  state.run([&](Region&) { bench::doNotOptimize(name.slice(1, -1)); });
+}
+
+NDNPH_BENCH(Name, GetComponent)
+{
+  StaticRegion<256> fixture;
+  Name name = Name::parse(fixture, URI);
+  state.run([&](Region&) { bench::doNotOptimize(name[-1]); });
+}
+
+} // namespace
+} // namespace ndnph
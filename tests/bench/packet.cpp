@@ -0,0 +1,155 @@
+#include "ndnph/keychain/digest.hpp"
+#include "ndnph/keychain/ec.hpp"
+#include "ndnph/keychain/null.hpp"
+#include "ndnph/packet/data.hpp"
+#include "ndnph/packet/interest.hpp"
+
+#include "bench-common.hpp"
+
+namespace ndnph {
+namespace {
+
+const char* URI = "/example/testApp/randomData/8=version/8=segment";
+
+/** @brief Encode an Encodable into region; return wire encoding or empty value on failure. */
+template<typename Encodable>
+tlv::Value
+encodeIn(Region& region, const Encodable& encodable)
+{
+  Encoder encoder(region);
+  if (!encoder.prepend(encodable)) {
+    encoder.discard();
+    return tlv::Value();
+  }
+  encoder.trim();
+  return tlv::Value(encoder);
+}
+
+NDNPH_BENCH(Interest, Encode)
+{
+  StaticRegion<512> fixture;
+  Interest interest = fixture.create<Interest>();
+  interest.setName(Name::parse(fixture, URI));
+  interest.setCanBePrefix(true);
+  interest.setMustBeFresh(true);
+  state.run([&](Region& region) { bench::doNotOptimize(encodeIn(region, interest)); });
+}
+
+NDNPH_BENCH(Interest, Decode)
+{
+  StaticRegion<512> fixture;
+  Interest interest = fixture.create<Interest>();
+  interest.setName(Name::parse(fixture, URI));
+  interest.setMustBeFresh(true);
+  tlv::Value wire = encodeIn(fixture, interest);
+  state.run([&](Region& region) {
+    Interest decoded = region.create<Interest>();
+    bench::doNotOptimize(wire.makeDecoder().decode(decoded));
+  });
+}
+
+NDNPH_BENCH(Interest, EncodeParameterized)
+{
+  StaticRegion<512> fixture;
+  Interest interest = fixture.create<Interest>();
+  interest.setName(Name::parse(fixture, URI));
+  uint8_t params[64] = {};
+  state.run([&](Region& region) {
+    bench::doNotOptimize(encodeIn(region, interest.parameterize(tlv::Value(params, 64))));
+  });
+}
+
+class DataFixture
+{
+public:
+  explicit DataFixture(size_t contentLen = 1024)
+    : content(contentLen)
+  {
+    data = region.create<Data>();
+    data.setName(Name::parse(region, URI));
+    data.setFreshnessPeriod(4000);
+    data.setContent(tlv::Value(content.data(), content.size()));
+  }
+
+public:
+  DynamicRegion region{ 4096 };
+  std::vector<uint8_t> content;
+  Data data;
+};
+
+NDNPH_BENCH(Data, EncodeNull)
+{
+  DataFixture f;
+  state.run([&](Region& region) {
+    bench::doNotOptimize(encodeIn(region, f.data.sign(NullKey::get())));
+  });
+}
+
+NDNPH_BENCH(Data, Decode)
+{
+  DataFixture f;
+  tlv::Value wire = encodeIn(f.region, f.data.sign(NullKey::get()));
+  state.run([&](Region& region) {
+    Data decoded = region.create<Data>();
+    bench::doNotOptimize(wire.makeDecoder().decode(decoded));
+  });
+}
+
+NDNPH_BENCH(Data, DecodeLazyNameOnly)
+{
+  DataFixture f;
+  tlv::Value wire = encodeIn(f.region, f.data.sign(NullKey::get()));
+  state.run([&](Region& region) {
+    Data decoded = region.create<Data>();
+    decoded.setLazyDecode(true);
+    bench::doNotOptimize(wire.makeDecoder().decode(decoded));
+    bench::doNotOptimize(decoded.getName());
+  });
+}
+
+NDNPH_BENCH(Data, SignDigest)
+{
+  DataFixture f;
+  state.run([&](Region& region) {
+    bench::doNotOptimize(encodeIn(region, f.data.sign(DigestKey::get())));
+  });
+}
+
+NDNPH_BENCH(Data, VerifyDigest)
+{
+  DataFixture f;
+  tlv::Value wire = encodeIn(f.region, f.data.sign(DigestKey::get()));
+  Data decoded = f.region.create<Data>();
+  wire.makeDecoder().decode(decoded);
+  state.run([&](Region&) { bench::doNotOptimize(decoded.verify(DigestKey::get())); });
+}
+
+NDNPH_BENCH(Data, SignEc)
+{
+  DataFixture f;
+  EcPrivateKey pvt;
+  EcPublicKey pub;
+  if (!ec::generate(f.region, Name::parse(f.region, "/K"), pvt, pub)) {
+    state.skip("EC unavailable");
+    return;
+  }
+  state.run([&](Region& region) { bench::doNotOptimize(encodeIn(region, f.data.sign(pvt))); });
+}
+
+NDNPH_BENCH(Data, VerifyEc)
+{
+  DataFixture f;
+  EcPrivateKey pvt;
+  EcPublicKey pub;
+  if (!ec::generate(f.region, Name::parse(f.region, "/K"), pvt, pub)) {
+    state.skip("EC unavailable");
+    return;
+  }
+  tlv::Value wire = encodeIn(f.region, f.data.sign(pvt));
+  Data decoded = f.region.create<Data>();
+  wire.makeDecoder().decode(decoded);
+  state.run([&](Region&) { bench::doNotOptimize(decoded.verify(pub)); });
+}
+
+} // namespace
+} // namespace ndnph
@@ -0,0 +1,71 @@
+#include "ndnph/tlv/ev-decoder.hpp"
+
+#include "bench-common.hpp"
+
+namespace ndnph {
+namespace {
+
+const uint8_t WIRE[] = {
+  0x06, 0x21, 0x07, 0x06, 0x08, 0x01, 0x41, 0x08, 0x01, 0x42, 0x14, 0x08,
+  0x18, 0x01, 0x01, 0x1A, 0x03, 0x08, 0x01, 0x42, 0x15, 0x02, 0xC0, 0xC1,
+  0x16, 0x03, 0x1B, 0x01, 0x10, 0x17, 0x04, 0xF0, 0xF1, 0xF2, 0xF3,
+};
+
+NDNPH_BENCH(Tlv, ReadVarNum1)
+{
+  const uint8_t input[] = { 0xFC };
+  state.run([&](Region&) {
+    uint32_t n = 0;
+    bench::doNotOptimize(tlv::readVarNum(input, sizeof(input), n));
+    bench::doNotOptimize(n);
+  });
+}
+
+NDNPH_BENCH(Tlv, ReadVarNum3)
+{
+  const uint8_t input[] = { 0xFD, 0x01, 0x00 };
+  state.run([&](Region&) {
+    uint32_t n = 0;
+    bench::doNotOptimize(tlv::readVarNum(input, sizeof(input), n));
+    bench::doNotOptimize(n);
+  });
+}
+
+NDNPH_BENCH(Tlv, ReadVarNum5)
+{
+  const uint8_t input[] = { 0xFE, 0x00, 0x01, 0x00, 0x00 };
+  state.run([&](Region&) {
+    uint32_t n = 0;
+    bench::doNotOptimize(tlv::readVarNum(input, sizeof(input), n));
+    bench::doNotOptimize(n);
+  });
+}
+
+NDNPH_BENCH(Decoder, IterateData)
+{
+  Decoder::Tlv data;
+  Decoder::readTlv(data, WIRE, WIRE + sizeof(WIRE));
+  state.run([&](Region&) {
+    for (const auto& d : data.vd()) {
+      bench::doNotOptimize(d.type);
+    }
+  });
+}
+
+NDNPH_BENCH(EvDecoder, DecodeData)
+{
+  Decoder::Tlv data;
+  Decoder::readTlv(data, WIRE, WIRE + sizeof(WIRE));
+  state.run([&](Region&) {
+    int n = 0;
+    auto count = [&n](const Decoder::Tlv&) { ++n; };
+    bool ok = EvDecoder::decode(data, { 0x06 }, EvDecoder::def<0x07>(count),
+                                EvDecoder::def<0x14>(count), EvDecoder::def<0x15>(count),
+                                EvDecoder::def<0x16>(count), EvDecoder::def<0x17>(count));
+    bench::doNotOptimize(ok);
+    bench::doNotOptimize(n);
+  });
+}
+
+} // namespace
+} // namespace ndnph
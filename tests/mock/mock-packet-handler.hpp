@@ -12,6 +12,7 @@ class MockPacketHandler : public PacketHandler
 public:
   using PacketHandler::getCurrentPacketInfo;
   using PacketHandler::PacketHandler;
+  using PacketHandler::retainCurrentPacket;
 
   template<typename... Arg>
   bool send(Arg&&... arg)
@@ -2,6 +2,7 @@
 #include "ndnph/app/ndncert/server.hpp"
 
 #include "mock/bridge-fixture.hpp"
+#include "mock/mock-packet-handler.hpp"
 #include "test-common.hpp"
 
 namespace ndnph {
@@ -50,7 +51,12 @@ protected:
     }
   }
 
-  void executeWorkflow(server::ChallengeList sChallenges, client::ChallengeList cChallenges)
+  /**
+   * @brief Execute certificate request workflow.
+   * @param nackNew if not None, the first NEW request is answered with a Nack of this reason.
+   */
+  void executeWorkflow(server::ChallengeList sChallenges, client::ChallengeList cChallenges,
+                       NackReason nackNew = NackReason::None)
   {
     server::NopChallenge sNopChallenge;
     Server server(Server::Options{
@@ -60,6 +66,19 @@ protected:
       .signer = sPvt,
     });
 
+    g::NiceMock<MockPacketHandler> hNack(faceA, -1);
+    ON_CALL(hNack, processInterest).WillByDefault([&](Interest interest) {
+      const Name& name = interest.getName();
+      if (name.size() < 2 || name[-2] != getNewComponent()) {
+        return false;
+      }
+      newRequests.emplace_back(interest.getNonce(), test::toString(name[-1]));
+      if (nackNew == NackReason::None || newRequests.size() > 1) {
+        return false;
+      }
+      return hNack.send(Nack::create(interest, nackNew), *hNack.getCurrentPacketInfo());
+    });
+
     client::NopChallenge cNopChallenge;
     runInThreads(
       [&] {
@@ -86,6 +105,7 @@ protected:
   EcPrivateKey cPvt;
   EcPublicKey cPub;
   std::string cIssuedCertName;
+  std::vector<std::pair<uint32_t, std::string>> newRequests; ///< nonce and digest of NEW requests
 };
 
 TEST_F(NdncertFixture, WorkflowNop)
@@ -96,6 +116,28 @@ TEST_F(NdncertFixture, WorkflowNop)
   EXPECT_THAT(cIssuedCertName, g::StartsWith(test::toString(cPub.getName())));
 }
 
+TEST_F(NdncertFixture, NackDuplicate)
+{
+  server::NopChallenge sNopChallenge;
+  client::NopChallenge cNopChallenge;
+  executeWorkflow({ &sNopChallenge }, { &cNopChallenge }, NackReason::Duplicate);
+  EXPECT_THAT(cIssuedCertName, g::StartsWith(test::toString(cPub.getName())));
+
+  // NEW request is re-signed and retransmitted with a fresh nonce
+  ASSERT_EQ(newRequests.size(), 2);
+  EXPECT_NE(newRequests[0].first, newRequests[1].first);
+  EXPECT_NE(newRequests[0].second, newRequests[1].second);
+}
+
+TEST_F(NdncertFixture, NackCongestion)
+{
+  server::NopChallenge sNopChallenge;
+  client::NopChallenge cNopChallenge;
+  executeWorkflow({ &sNopChallenge }, { &cNopChallenge }, NackReason::Congestion);
+  EXPECT_EQ(cIssuedCertName, "FAIL");
+  EXPECT_EQ(newRequests.size(), 1);
+}
+
 TEST_F(NdncertFixture, WorkflowPossession)
 {
   DynamicRegion oRegion(4095);
@@ -4,6 +4,7 @@
 
 #include "mock/bridge-fixture.hpp"
 #include "mock/mock-key.hpp"
+#include "mock/mock-packet-handler.hpp"
 #include "mock/mock-transport.hpp"
 #include "test-common.hpp"
 
@@ -53,6 +54,61 @@ TEST(Ping, Client)
   auto cnt = client.readCounters();
   EXPECT_EQ(cnt.nTxInterests, nInterests);
   EXPECT_EQ(cnt.nRxData, cnt.nTxInterests - 2);
+  EXPECT_TRUE(client.getRttEstimator().hasMeasurement());
+  EXPECT_LE(client.getRttEstimator().getSrtt(), 2);
+}
+
+TEST(Ping, ClientNack)
+{
+  g::NiceMock<MockTransport> transport;
+  Face face(transport);
+
+  StaticRegion<1024> region;
+  PingClient client(Name::parse(region, "/ping"), face, 10);
+
+  std::vector<std::string> names;
+  std::vector<uint32_t> nonces;
+  std::vector<port::Clock::Time> times;
+  EXPECT_CALL(transport, doSend).WillRepeatedly([&](std::vector<uint8_t> wire, uint64_t) {
+    StaticRegion<1024> region;
+    Interest interest = region.create<Interest>();
+    EXPECT_TRUE(Decoder(wire.data(), wire.size()).decode(interest));
+    names.push_back(test::toString(interest.getName()));
+    nonces.push_back(interest.getNonce());
+    times.push_back(port::Clock::now());
+
+    switch (names.size()) {
+      case 1:
+      case 2:
+        transport.receive(region, lp::encode(Nack::create(interest, NackReason::Duplicate)));
+        break;
+      case 3:
+        transport.receive(region, lp::encode(Nack::create(interest, NackReason::Congestion)));
+        break;
+      default: {
+        Data data = region.create<Data>();
+        data.setName(interest.getName());
+        transport.receive(data.sign(NullKey::get()));
+        break;
+      }
+    }
+    return true;
+  });
+
+  for (int i = 0; i < 60 && names.size() < 4; ++i) {
+    face.loop();
+    port::Clock::sleep(1);
+  }
+  ASSERT_GE(names.size(), 4);
+  EXPECT_EQ(names[0], names[1]); // retransmission upon Duplicate
+  EXPECT_NE(nonces[0], nonces[1]);
+  EXPECT_NE(names[1], names[2]); // no retransmission upon second Duplicate
+  EXPECT_GE(port::Clock::sub(times[3], times[2]), 18); // deferred upon Congestion
+
+  auto cnt = client.readCounters();
+  EXPECT_EQ(cnt.nTxInterests, 4);
+  EXPECT_EQ(cnt.nRxNacks, 3);
+  EXPECT_EQ(cnt.nRxData, 1);
 }
 
 TEST(Ping, Server)
@@ -89,6 +145,44 @@ TEST(Ping, Server)
   EXPECT_THAT(dataNames, g::ElementsAreArray(interestNames));
 }
 
+TEST(Ping, ServerRxInPlace)
+{
+  auto run = [](size_t rxRoom) {
+    BridgeTransport transportA;
+    BridgeTransport transportB(64, rxRoom);
+    EXPECT_TRUE(transportA.begin(transportB));
+    Face faceA(transportA);
+    Face faceB(transportB);
+    faceB.setRxInPlace(true);
+
+    StaticRegion<1024> region;
+    PingServer server(Name::parse(region, "/ping"), faceB);
+    g::NiceMock<MockPacketHandler> hA(faceA);
+    int nData = 0;
+    ON_CALL(hA, processData).WillByDefault([&](Data) {
+      ++nData;
+      return true;
+    });
+
+    for (int i = 0; i < 4; ++i) {
+      StaticRegion<1024> region2;
+      Interest interest = region2.create<Interest>();
+      interest.setName(Name::parse(region2, ("/ping/" + std::to_string(i)).data()));
+      EXPECT_TRUE(hA.send(interest));
+      faceB.loop();
+      faceA.loop();
+    }
+    return nData;
+  };
+
+  size_t interestRoom = Region::sizeofAligned(sizeof(detail::InterestObj)) + 16;
+  size_t dataRoom = Region::sizeofAligned(sizeof(detail::DataObj)) + 256;
+  // RX buffer has room for decoding Interest in place, but not for creating Data
+  EXPECT_EQ(run(interestRoom), 0);
+  // rxRoom is sized for the reply
+  EXPECT_EQ(run(interestRoom + dataRoom), 4);
+}
+
 using PingEndToEndFixture = BridgeFixture;
 
 TEST_F(PingEndToEndFixture, EndToEnd)
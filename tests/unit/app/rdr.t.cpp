@@ -2,6 +2,7 @@
 #include "ndnph/port/clock/port.hpp"
 
 #include "mock/bridge-fixture.hpp"
+#include "mock/mock-packet-handler.hpp"
 #include "mock/mock-transport.hpp"
 #include "test-common.hpp"
 
@@ -111,9 +112,11 @@ TEST_F(RdrEndToEndFixture, Consumer)
                                  .freshnessPeriod = 6,
                                  .signer = DigestKey::get(),
                                });
+  RttEstimator rtt;
   RdrMetadataConsumer consumer(faceB, RdrMetadataConsumer::Options{
                                         .verifier = DigestKey::get(),
                                         .interestLifetime = 100,
+                                        .rtt = &rtt,
                                       });
 
   hasCallback = false;
@@ -125,6 +128,107 @@ TEST_F(RdrEndToEndFixture, Consumer)
   producer.setDatasetPrefix(expectedName);
   consumer.start(rdrPrefix2, consumerCallback, this);
   runInThreads([] {}, [&] { return !hasCallback; });
+  EXPECT_TRUE(rtt.hasMeasurement());
+}
+
+TEST_F(RdrEndToEndFixture, ConsumerSlowReply)
+{
+  StaticRegion<1024> prefixRegion;
+  auto rdrPrefix = Name::parse(prefixRegion, "/dataset");
+
+  g::NiceMock<MockPacketHandler> hA(faceA);
+  StaticRegion<1024> iRegion;
+  Name interestName;
+  PacketHandler::PacketInfo interestPi;
+  EXPECT_CALL(hA, processInterest).WillRepeatedly([&](Interest interest) {
+    interestName = interest.getName().clone(iRegion);
+    interestPi = *hA.getCurrentPacketInfo();
+    return true;
+  });
+
+  RttEstimator::Options rttOpts;
+  rttOpts.initRto = 10;
+  rttOpts.minRto = 10;
+  RttEstimator rtt(rttOpts);
+  RdrMetadataConsumer consumer(faceB, RdrMetadataConsumer::Options{
+                                        .verifier = DigestKey::get(),
+                                        .interestLifetime = 500,
+                                        .rtt = &rtt,
+                                      });
+
+  struct Result
+  {
+    int nCallbacks = 0;
+    bool hasData = false;
+  } result;
+  consumer.start(
+    rdrPrefix,
+    [](void* ctx, Data data) {
+      Result& result = *static_cast<Result*>(ctx);
+      ++result.nCallbacks;
+      result.hasData = !!data;
+    },
+    &result);
+
+  // reply arrives well after RTO, but before InterestLifetime
+  auto t0 = port::Clock::now();
+  while (port::Clock::sub(port::Clock::now(), t0) < 50) {
+    faceB.loop();
+    faceA.loop();
+    port::Clock::sleep(1);
+  }
+  EXPECT_EQ(result.nCallbacks, 0);
+  ASSERT_EQ(interestName.size(), 2);
+
+  StaticRegion<1024> region;
+  Data data = region.create<Data>();
+  ASSERT_FALSE(!data);
+  data.setName(interestName.append<convention::Version>(region, 1)
+                 .append<convention::Segment>(region, 0));
+  data.setFreshnessPeriod(1);
+  ASSERT_TRUE(hA.send(region, data.sign(DigestKey::get()), interestPi));
+  for (int i = 0; i < 10 && result.nCallbacks == 0; ++i) {
+    faceB.loop();
+    port::Clock::sleep(1);
+  }
+  EXPECT_EQ(result.nCallbacks, 1);
+  EXPECT_TRUE(result.hasData);
+  EXPECT_TRUE(rtt.hasMeasurement());
+}
+
+TEST_F(RdrEndToEndFixture, ConsumerNack)
+{
+  StaticRegion<1024> prefixRegion;
+  auto rdrPrefix = Name::parse(prefixRegion, "/dataset");
+
+  g::NiceMock<MockPacketHandler> hA(faceA);
+  std::vector<NackReason> reasons;
+  EXPECT_CALL(hA, processInterest).WillRepeatedly([&](Interest interest) {
+    NackReason reason = reasons.empty() ? NackReason::NoRoute : reasons.front();
+    if (!reasons.empty()) {
+      reasons.erase(reasons.begin());
+    }
+    hA.send(Nack::create(interest, reason), *hA.getCurrentPacketInfo());
+    return true;
+  });
+
+  RttEstimator rtt;
+  RdrMetadataConsumer consumer(faceB, RdrMetadataConsumer::Options{
+                                        .verifier = DigestKey::get(),
+                                        .interestLifetime = 1000,
+                                        .rtt = &rtt,
+                                      });
+
+  for (auto reason : { NackReason::Duplicate, NackReason::Congestion, NackReason::NoRoute }) {
+    reasons = { NackReason::Duplicate, reason };
+    hasCallback = false;
+    auto t0 = port::Clock::now();
+    consumer.start(rdrPrefix, consumerCallback, this);
+    runInThreads([] {}, [&] { return !hasCallback; });
+    EXPECT_LT(port::Clock::sub(port::Clock::now(), t0), 500);
+    EXPECT_TRUE(reasons.empty());
+  }
+  EXPECT_EQ(rtt.getRto(), 2000); // backoff upon Congestion
 }
 
 } // namespace
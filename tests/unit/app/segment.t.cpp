@@ -1,10 +1,14 @@
 #include "ndnph/app/segment-consumer.hpp"
 #include "ndnph/app/segment-producer.hpp"
+#include "ndnph/port/fs/port.hpp"
 
 #include "mock/bridge-fixture.hpp"
+#include "mock/mock-packet-handler.hpp"
 #include "mock/mock-transport.hpp"
 #include "test-common.hpp"
 
+#include <set>
+
 namespace ndnph {
 namespace {
 
@@ -45,9 +49,11 @@ TEST(Segment, Consumer)
 
   EXPECT_CALL(transport, doSend).WillRepeatedly([&](std::vector<uint8_t> wire, uint64_t) {
     StaticRegion<1024> region;
+    lp::PacketClassify classify;
+    EXPECT_TRUE(Decoder(wire.data(), wire.size()).decode(classify));
     Interest interest = region.create<Interest>();
     assert(!!interest);
-    EXPECT_TRUE(Decoder(wire.data(), wire.size()).decode(interest));
+    EXPECT_TRUE(classify.decodeInterest(interest));
 
     const Name& interestName = interest.getName();
     if (interestName == nameA0) {
@@ -139,6 +145,88 @@ TEST(Segment, Consumer)
   EXPECT_TRUE(destB.hasError);
 }
 
+TEST(Segment, ConsumerNack)
+{
+  g::NiceMock<MockTransport> transport;
+  Face face(transport);
+
+  StaticRegion<1024> encodingRegion;
+  SegmentConsumer::Options opts;
+  opts.rtt.initRto = 20;
+  opts.rtt.minRto = 20;
+  SegmentConsumer consumer(face, encodingRegion, opts);
+
+  StaticRegion<1024> prefixRegion;
+  Name prefix = Name::parse(prefixRegion, "/A");
+  struct Sent
+  {
+    uint64_t segment;
+    uint32_t nonce;
+    uint64_t pitToken;
+    port::Clock::Time time;
+  };
+  std::vector<Sent> sent;
+  EXPECT_CALL(transport, doSend).WillRepeatedly([&](std::vector<uint8_t> wire, uint64_t) {
+    StaticRegion<1024> region;
+    lp::PacketClassify classify;
+    EXPECT_TRUE(Decoder(wire.data(), wire.size()).decode(classify));
+    Interest interest = region.create<Interest>();
+    assert(!!interest);
+    EXPECT_TRUE(classify.decodeInterest(interest));
+    uint64_t pitToken = classify.getPitToken();
+    sent.push_back(Sent{ interest.getName()[-1].as<convention::Segment>(), interest.getNonce(),
+                         pitToken, port::Clock::now() });
+
+    switch (sent.size()) {
+      case 1:
+        transport.receive(region,
+                          lp::encode(Nack::create(interest, NackReason::Duplicate), pitToken));
+        break;
+      case 2:
+        // late Nack of previous transmission is ignored
+        transport.receive(
+          region, lp::encode(Nack::create(interest, NackReason::NoRoute), sent[0].pitToken));
+        transport.receive(region,
+                          lp::encode(Nack::create(interest, NackReason::Congestion), pitToken));
+        break;
+      case 3: {
+        Data data = region.create<Data>();
+        assert(!!data);
+        data.setName(interest.getName());
+        transport.receive(data.sign(DigestKey::get()));
+        break;
+      }
+      default:
+        transport.receive(region,
+                          lp::encode(Nack::create(interest, NackReason::NoRoute), pitToken));
+        break;
+    }
+    return true;
+  });
+
+  std::vector<uint8_t> output(64);
+  SegmentConsumer::SaveDest dest(output.data(), output.size());
+  consumer.saveTo(dest);
+  consumer.start(prefix);
+  for (int i = 0; i < 200 && consumer.isRunning(); ++i) {
+    face.loop();
+    port::Clock::sleep(1);
+  }
+
+  EXPECT_FALSE(consumer.isRunning());
+  EXPECT_TRUE(dest.hasError);
+  ASSERT_EQ(sent.size(), 4);
+  EXPECT_EQ(sent[0].segment, 0);
+  EXPECT_EQ(sent[1].segment, 0);
+  EXPECT_EQ(sent[2].segment, 0);
+  EXPECT_EQ(sent[3].segment, 1);
+  EXPECT_NE(sent[0].nonce, sent[1].nonce);
+  EXPECT_NE(sent[1].nonce, sent[2].nonce);
+  EXPECT_NE(sent[0].pitToken, sent[1].pitToken);
+  // Congestion Nack delays retransmission by backed off RTO
+  EXPECT_GE(port::Clock::sub(sent[2].time, sent[1].time), 40);
+}
+
 TEST(Segment, Producer)
 {
   g::NiceMock<MockTransport> transport;
@@ -210,6 +298,400 @@ TEST(Segment, Producer)
   testOneInterest("/A/AA/AAA/33=%03", false, nullptr, -1);
 }
 
+TEST(Segment, ProducerCache)
+{
+  g::NiceMock<MockTransport> transport;
+  Face face(transport);
+
+  StaticRegion<1024> encodingRegion;
+  StaticRegion<2048> cacheRegion;
+  std::vector<uint8_t> content = makeRandomContent(2000);
+  SegmentProducer::Options opts;
+  opts.contentLen = 300;
+  opts.cache = &cacheRegion;
+  SegmentProducer producer(face, encodingRegion, opts);
+
+  std::vector<uint8_t> reply;
+  EXPECT_CALL(transport, doSend).WillRepeatedly([&](std::vector<uint8_t> wire, uint64_t) {
+    reply = wire;
+    return true;
+  });
+  auto request = [&](const Name& prefix, uint64_t segment) {
+    StaticRegion<1024> region;
+    Interest interest = region.create<Interest>();
+    assert(!!interest);
+    interest.setName(prefix.append<convention::Segment>(region, segment));
+    reply.clear();
+    transport.receive(interest);
+    return reply;
+  };
+
+  // a cached segment is not re-encoded, so that it does not reflect changes in content buffer
+  StaticRegion<1024> prefixRegion;
+  Name prefixA = Name::parse(prefixRegion, "/A");
+  producer.setContent(prefixA, content.data(), 900);
+  auto a0 = request(prefixA, 0);
+  ASSERT_FALSE(a0.empty());
+  content[0] ^= 0xFF;
+  EXPECT_EQ(request(prefixA, 0), a0);
+
+  EXPECT_EQ(producer.presign(), 3);
+  content[600] ^= 0xFF;
+  auto a2 = request(prefixA, 2);
+  Data data = prefixRegion.create<Data>();
+  ASSERT_FALSE(!data);
+  ASSERT_TRUE(Decoder(a2.data(), a2.size()).decode(data));
+  EXPECT_EQ(data.getName(), prefixA.append<convention::Segment>(prefixRegion, 2));
+  EXPECT_TRUE(data.getIsFinalBlock());
+  EXPECT_EQ(data.getContent().size(), 300);
+  EXPECT_EQ(data.getContent().begin()[0], content[600] ^ 0xFF);
+
+  // setContent clears the cache; segments that do not fit are encoded upon every request
+  Name prefixB = Name::parse(prefixRegion, "/B");
+  producer.setContent(prefixB, content.data(), content.size());
+  EXPECT_NE(request(prefixB, 0), a0);
+  uint64_t nCached = producer.presign();
+  EXPECT_GE(nCached, 3);
+  EXPECT_LT(nCached, 7);
+  auto b6 = request(prefixB, 6);
+  ASSERT_FALSE(b6.empty());
+  content[1800] ^= 0xFF;
+  EXPECT_NE(request(prefixB, 6), b6);
+}
+
+using SegmentPipelineFixture = BridgeFixture;
+
+TEST_F(SegmentPipelineFixture, Reorder)
+{
+  StaticRegion<1024> prefixRegion;
+  Name prefix = Name::parse(prefixRegion, "/P");
+  const uint64_t finalSegment = 9;
+
+  g::NiceMock<MockPacketHandler> hA(faceA);
+  std::vector<uint64_t> sent;
+  std::vector<std::pair<uint64_t, uint64_t>> pending;
+  EXPECT_CALL(hA, processInterest).WillRepeatedly([&](Interest interest) {
+    uint64_t segment = interest.getName()[-1].as<convention::Segment>();
+    sent.push_back(segment);
+    if (segment <= finalSegment && !(segment == 3 && std::count(sent.begin(), sent.end(), 3) == 1)) {
+      pending.emplace_back(segment, hA.getCurrentPacketInfo()->pitToken);
+    }
+    return true;
+  });
+
+  StaticRegion<1024> regionB;
+  PipelinedSegmentConsumer::Options opts;
+  opts.initCwnd = 2;
+  opts.maxCwnd = 8;
+  opts.retxLimit = 2;
+  opts.retxDelay = 20;
+  PipelinedSegmentConsumer consumer(faceB, regionB, opts);
+  std::vector<std::pair<uint64_t, int>> received;
+  consumer.setSegmentCallback(
+    [](void* ctx, uint64_t segment, Data data) {
+      auto& received = *static_cast<std::vector<std::pair<uint64_t, int>>*>(ctx);
+      received.emplace_back(segment, !data ? -1 : data.getContent().begin()[0]);
+    },
+    &received);
+  consumer.start(prefix);
+
+  uint16_t maxInFlight = 0;
+  for (int i = 0; i < 1000 && consumer.isRunning(); ++i) {
+    faceB.loop();
+    maxInFlight = std::max(maxInFlight, consumer.countInFlight());
+    faceA.loop();
+
+    // reply in reverse order
+    for (auto it = pending.rbegin(); it != pending.rend(); ++it) {
+      StaticRegion<1024> region;
+      Data data = region.create<Data>();
+      ASSERT_FALSE(!data);
+      data.setName(prefix.append<convention::Segment>(region, it->first));
+      uint8_t content = it->first;
+      data.setContent(tlv::Value(&content, 1));
+      data.setIsFinalBlock(it->first == finalSegment);
+      PacketHandler::PacketInfo pi;
+      pi.pitToken = it->second;
+      ASSERT_TRUE(hA.send(region, data.sign(DigestKey::get()), pi));
+    }
+    pending.clear();
+    port::Clock::sleep(1);
+  }
+  EXPECT_FALSE(consumer.isRunning());
+
+  ASSERT_EQ(received.size(), finalSegment + 1);
+  for (uint64_t segment = 0; segment <= finalSegment; ++segment) {
+    EXPECT_EQ(received[segment].first, segment);
+    EXPECT_EQ(received[segment].second, static_cast<int>(segment));
+  }
+  EXPECT_EQ(std::count(sent.begin(), sent.end(), 3), 2);
+  EXPECT_GE(maxInFlight, 4);
+  EXPECT_EQ(consumer.countInFlight(), 0);
+  EXPECT_TRUE(consumer.getRttEstimator().hasMeasurement());
+}
+
+TEST_F(SegmentPipelineFixture, OversizedReorder)
+{
+  StaticRegion<1024> prefixRegion;
+  Name prefix = Name::parse(prefixRegion, "/P");
+  const uint64_t finalSegment = 5;
+
+  g::NiceMock<MockPacketHandler> hA(faceA);
+  std::vector<uint64_t> sent;
+  std::vector<std::pair<uint64_t, uint64_t>> pending;
+  EXPECT_CALL(hA, processInterest).WillRepeatedly([&](Interest interest) {
+    uint64_t segment = interest.getName()[-1].as<convention::Segment>();
+    sent.push_back(segment);
+    if (segment <= finalSegment) {
+      pending.emplace_back(segment, hA.getCurrentPacketInfo()->pitToken);
+    }
+    return true;
+  });
+
+  StaticRegion<1024> regionB;
+  PipelinedSegmentConsumer::Options opts;
+  opts.initCwnd = 4;
+  opts.maxCwnd = 4;
+  opts.retxLimit = 0;
+  opts.maxDataLen = 64; // shorter than every Data
+  PipelinedSegmentConsumer consumer(faceB, regionB, opts);
+  std::vector<uint8_t> output(1024);
+  SegmentConsumer::SaveDest dest(output.data(), output.size());
+  consumer.saveTo(dest);
+  consumer.start(prefix);
+
+  for (int i = 0; i < 1000 && consumer.isRunning(); ++i) {
+    faceB.loop();
+    faceA.loop();
+
+    // reply in reverse order
+    for (auto it = pending.rbegin(); it != pending.rend(); ++it) {
+      StaticRegion<1024> region;
+      Data data = region.create<Data>();
+      ASSERT_FALSE(!data);
+      data.setName(prefix.append<convention::Segment>(region, it->first));
+      std::vector<uint8_t> content(100, static_cast<uint8_t>(it->first));
+      data.setContent(tlv::Value(content.data(), content.size()));
+      data.setIsFinalBlock(it->first == finalSegment);
+      PacketHandler::PacketInfo pi;
+      pi.pitToken = it->second;
+      ASSERT_TRUE(hA.send(region, data.sign(DigestKey::get()), pi));
+    }
+    pending.clear();
+    port::Clock::sleep(1);
+  }
+  EXPECT_FALSE(consumer.isRunning());
+
+  // Data that arrived out of order is requested again, not counted as retransmission
+  EXPECT_TRUE(dest.isCompleted);
+  EXPECT_FALSE(dest.hasError);
+  ASSERT_EQ(dest.length, 600);
+  for (uint64_t segment = 0; segment <= finalSegment; ++segment) {
+    EXPECT_THAT(std::vector<uint8_t>(&output[100 * segment], &output[100 * (segment + 1)]),
+                g::Each(segment));
+  }
+  EXPECT_GT(sent.size(), finalSegment + 1);
+}
+
+TEST_F(SegmentPipelineFixture, Timeout)
+{
+  StaticRegion<1024> prefixRegion;
+  Name prefix = Name::parse(prefixRegion, "/P");
+
+  g::NiceMock<MockPacketHandler> hA(faceA);
+  int nInterests = 0;
+  EXPECT_CALL(hA, processInterest).WillRepeatedly([&](Interest) {
+    ++nInterests;
+    return true;
+  });
+
+  StaticRegion<1024> regionB;
+  PipelinedSegmentConsumer::Options opts;
+  opts.initCwnd = 4;
+  opts.retxLimit = 1;
+  opts.retxDelay = 10;
+  PipelinedSegmentConsumer consumer(faceB, regionB, opts);
+  std::vector<uint8_t> output(64);
+  SegmentConsumer::SaveDest dest(output.data(), output.size());
+  consumer.saveTo(dest);
+  consumer.start(prefix);
+
+  for (int i = 0; i < 1000 && consumer.isRunning(); ++i) {
+    faceB.loop();
+    faceA.loop();
+    port::Clock::sleep(1);
+  }
+  EXPECT_FALSE(consumer.isRunning());
+  EXPECT_TRUE(dest.hasError);
+  EXPECT_LT(consumer.getCwnd(), 4);
+  EXPECT_GE(nInterests, 5);
+}
+
+TEST_F(SegmentPipelineFixture, RtoBackoff)
+{
+  StaticRegion<1024> prefixRegion;
+  Name prefix = Name::parse(prefixRegion, "/P");
+  const uint64_t finalSegment = 3;
+
+  StaticRegion<1024> regionB;
+  PipelinedSegmentConsumer::Options opts;
+  opts.initCwnd = 4;
+  opts.retxLimit = 3;
+  opts.rtt.initRto = 10;
+  opts.rtt.minRto = 10;
+  opts.rtt.maxRto = 1000;
+  PipelinedSegmentConsumer consumer(faceB, regionB, opts);
+
+  g::NiceMock<MockPacketHandler> hA(faceA);
+  std::set<uint64_t> seen;
+  std::vector<int> rtos;
+  std::vector<std::pair<uint64_t, uint64_t>> pending;
+  EXPECT_CALL(hA, processInterest).WillRepeatedly([&](Interest interest) {
+    uint64_t segment = interest.getName()[-1].as<convention::Segment>();
+    if (seen.insert(segment).second) { // whole initial window is dropped
+      return true;
+    }
+    rtos.push_back(consumer.getRttEstimator().getRto());
+    if (segment <= finalSegment) {
+      pending.emplace_back(segment, hA.getCurrentPacketInfo()->pitToken);
+    }
+    return true;
+  });
+
+  std::vector<uint8_t> output(64);
+  SegmentConsumer::SaveDest dest(output.data(), output.size());
+  consumer.saveTo(dest);
+  consumer.start(prefix);
+
+  for (int i = 0; i < 2000 && consumer.isRunning(); ++i) {
+    faceB.loop();
+    faceA.loop();
+    for (const auto& p : pending) {
+      StaticRegion<1024> region;
+      Data data = region.create<Data>();
+      ASSERT_FALSE(!data);
+      data.setName(prefix.append<convention::Segment>(region, p.first));
+      data.setIsFinalBlock(p.first == finalSegment);
+      PacketHandler::PacketInfo pi;
+      pi.pitToken = p.second;
+      ASSERT_TRUE(hA.send(region, data.sign(DigestKey::get()), pi));
+    }
+    pending.clear();
+    port::Clock::sleep(1);
+  }
+  EXPECT_FALSE(consumer.isRunning());
+  EXPECT_FALSE(dest.hasError);
+
+  // losing a whole window is one congestion event, so RTO doubles only once
+  ASSERT_EQ(rtos.size(), 4);
+  EXPECT_EQ(rtos.front(), 2 * opts.rtt.initRto);
+  EXPECT_THAT(rtos, g::Each(g::Le(2 * opts.rtt.initRto)));
+}
+
+TEST_F(SegmentPipelineFixture, Nack)
+{
+  StaticRegion<1024> prefixRegion;
+  Name prefix = Name::parse(prefixRegion, "/P");
+  Name prefixNoRoute = Name::parse(prefixRegion, "/Q");
+  const uint64_t finalSegment = 5;
+
+  g::NiceMock<MockPacketHandler> hA(faceA);
+  std::vector<Name> sent;
+  struct Reply
+  {
+    Name name;
+    uint64_t pitToken;
+    NackReason reason;
+  };
+  std::vector<Reply> pending;
+  StaticRegion<4096> nameRegion;
+  EXPECT_CALL(hA, processInterest).WillRepeatedly([&](Interest interest) {
+    Name name = interest.getName().clone(nameRegion);
+    auto nSent = std::count(sent.begin(), sent.end(), name);
+    sent.push_back(name);
+
+    NackReason reason = NackReason::None;
+    if (prefixNoRoute.isPrefixOf(name)) {
+      reason = NackReason::NoRoute;
+    } else if (nSent == 0) {
+      switch (name[-1].as<convention::Segment>()) {
+        case 1:
+          reason = NackReason::Congestion;
+          break;
+        case 2:
+          reason = NackReason::Duplicate;
+          break;
+      }
+    }
+    pending.push_back(Reply{ name, hA.getCurrentPacketInfo()->pitToken, reason });
+    return true;
+  });
+
+  StaticRegion<1024> regionB;
+  PipelinedSegmentConsumer::Options opts;
+  opts.initCwnd = 4;
+  opts.maxCwnd = 8;
+  opts.retxDelay = 1000;
+  PipelinedSegmentConsumer consumer(faceB, regionB, opts);
+  std::vector<uint8_t> output(64);
+  SegmentConsumer::SaveDest dest(output.data(), output.size());
+  consumer.saveTo(dest);
+
+  auto run = [&] {
+    for (int i = 0; i < 200 && consumer.isRunning(); ++i) {
+      faceB.loop();
+      faceA.loop();
+      for (const Reply& reply : pending) {
+        StaticRegion<1024> region;
+        PacketHandler::PacketInfo pi;
+        pi.pitToken = reply.pitToken;
+        if (reply.reason == NackReason::None) {
+          Data data = region.create<Data>();
+          ASSERT_FALSE(!data);
+          data.setName(reply.name);
+          uint8_t content = reply.name[-1].as<convention::Segment>();
+          data.setContent(tlv::Value(&content, 1));
+          data.setIsFinalBlock(content == finalSegment);
+          ASSERT_TRUE(hA.send(region, data.sign(DigestKey::get()), pi));
+        } else {
+          Interest interest = region.create<Interest>();
+          ASSERT_FALSE(!interest);
+          interest.setName(reply.name);
+          ASSERT_TRUE(hA.send(region, Nack::create(interest, reply.reason), pi));
+        }
+      }
+      pending.clear();
+      port::Clock::sleep(1);
+    }
+  };
+
+  auto t0 = port::Clock::now();
+  consumer.start(prefix);
+  run();
+  EXPECT_FALSE(consumer.isRunning());
+  EXPECT_TRUE(dest.isCompleted);
+  EXPECT_FALSE(dest.hasError);
+  EXPECT_THAT(std::vector<uint8_t>(&dest.output[0], &dest.output[dest.length]),
+              g::ElementsAre(0, 1, 2, 3, 4, 5));
+  EXPECT_EQ(std::count_if(sent.begin(), sent.end(),
+                          [](const Name& name) { return name[-1].as<convention::Segment>() == 1; }),
+            2);
+  EXPECT_EQ(std::count_if(sent.begin(), sent.end(),
+                          [](const Name& name) { return name[-1].as<convention::Segment>() == 2; }),
+            2);
+  EXPECT_LT(port::Clock::sub(port::Clock::now(), t0), 500);
+
+  sent.clear();
+  SegmentConsumer::SaveDest destNoRoute(output.data(), output.size());
+  consumer.saveTo(destNoRoute);
+  t0 = port::Clock::now();
+  consumer.start(prefixNoRoute);
+  run();
+  EXPECT_FALSE(consumer.isRunning());
+  EXPECT_TRUE(destNoRoute.hasError);
+  EXPECT_LT(port::Clock::sub(port::Clock::now(), t0), 500);
+}
+
 class SegmentEndToEndFixture : public BridgeFixture
 {
 protected:
@@ -286,6 +768,7 @@ TEST_F(SegmentEndToEndFixture, SaveToNormal)
   EXPECT_TRUE(destB.isCompleted);
   EXPECT_FALSE(destB.hasError);
   EXPECT_EQ(destB.length, contentA.size());
+  EXPECT_TRUE(consumerB->getRttEstimator().hasMeasurement());
   EXPECT_THAT(std::vector<uint8_t>(&destB.output[0], &destB.output[destB.length]),
               g::ElementsAreArray(contentA));
 }
@@ -305,5 +788,95 @@ TEST_F(SegmentEndToEndFixture, SaveToTooShort)
   EXPECT_TRUE(destB.hasError);
 }
 
+TEST_F(SegmentEndToEndFixture, StreamToFile)
+{
+  char filename[] = "/tmp/NDNph-segment-XXXXXX";
+  int fd = mkstemp(filename);
+  ASSERT_GE(fd, 0);
+  std::vector<uint8_t> junk(contentA.size() * 2, 0xEE);
+  ASSERT_EQ(write(fd, junk.data(), junk.size()), static_cast<ssize_t>(junk.size()));
+
+  PipelinedSegmentConsumer::Options opts;
+  opts.maxCwnd = 4;
+  PipelinedSegmentConsumer consumer(faceB, regionB, opts);
+  port::FileWriter writer(fd);
+  SegmentConsumer::StreamDest destB(port::FileWriter::write, &writer, port::FileWriter::complete,
+                                    &writer);
+
+  runInThreads(
+    [&] {
+      consumer.saveTo(destB);
+      consumer.start(prefix);
+    },
+    [&] { return consumer.isRunning(); });
+
+  EXPECT_TRUE(destB.isCompleted);
+  EXPECT_FALSE(destB.hasError);
+  EXPECT_EQ(destB.length, contentA.size());
+
+  // FileWriter::complete truncates junk after the content
+  std::vector<uint8_t> contentB(junk.size());
+  ssize_t nRead = pread(fd, contentB.data(), contentB.size(), 0);
+  ASSERT_EQ(nRead, static_cast<ssize_t>(contentA.size()));
+  contentB.resize(nRead);
+  EXPECT_EQ(contentB, contentA);
+  close(fd);
+  unlink(filename);
+}
+
+TEST_F(SegmentEndToEndFixture, StreamWriteError)
+{
+  g::NiceMock<MockPacketHandler> hA(faceA, -1);
+  uint64_t maxSegment = 0;
+  EXPECT_CALL(hA, processInterest).WillRepeatedly([&](Interest interest) {
+    maxSegment = std::max(maxSegment, interest.getName()[-1].as<convention::Segment>());
+    return false; // let producer reply
+  });
+
+  std::vector<uint64_t> offsets;
+  SegmentConsumer::StreamDest destB(
+    [](void* ctx, uint64_t offset, tlv::Value) {
+      auto& offsets = *static_cast<std::vector<uint64_t>*>(ctx);
+      offsets.push_back(offset);
+      return offsets.size() < 3;
+    },
+    &offsets);
+
+  runInThreads(
+    [&] {
+      consumerB->saveTo(destB);
+      consumerB->start(prefix);
+    },
+    [&] { return consumerB->isRunning(); });
+
+  EXPECT_FALSE(destB.isCompleted);
+  EXPECT_TRUE(destB.hasError);
+  EXPECT_EQ(destB.length, 512);
+  EXPECT_THAT(offsets, g::ElementsAre(0, 256, 512));
+  EXPECT_EQ(maxSegment, 2); // fetching stops upon write error
+}
+
+TEST_F(SegmentEndToEndFixture, Pipelined)
+{
+  PipelinedSegmentConsumer::Options opts;
+  opts.maxCwnd = 4;
+  PipelinedSegmentConsumer consumer(faceB, regionB, opts);
+  std::vector<uint8_t> contentB(contentA.size());
+  SegmentConsumer::SaveDest destB(contentB.data(), contentB.size());
+
+  runInThreads(
+    [&] {
+      consumer.saveTo(destB);
+      consumer.start(prefix);
+    },
+    [&] { return consumer.isRunning(); });
+
+  EXPECT_TRUE(destB.isCompleted);
+  EXPECT_FALSE(destB.hasError);
+  EXPECT_EQ(contentB, contentA);
+  EXPECT_TRUE(consumer.getRttEstimator().hasMeasurement());
+  EXPECT_LT(consumer.getRttEstimator().getRto(), 1000);
+}
+
 } // namespace
 } // namespace ndnph
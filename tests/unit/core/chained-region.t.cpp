@@ -0,0 +1,137 @@
+#include "ndnph/core/chained-region.hpp"
+#include "ndnph/tlv/value.hpp"
+
+#include "test-common.hpp"
+
+namespace ndnph {
+namespace {
+
+TEST(ChainedRegion, Grow)
+{
+  ChunkPool pool(60, 2);
+  EXPECT_EQ(pool.getChunkSize(), 64);
+  EXPECT_EQ(pool.countAvailable(), 2);
+
+  ChainedRegion region(pool, 32);
+  EXPECT_EQ(region.available(), 32);
+  EXPECT_EQ(region.countExtraChunks(), 0);
+
+  uint8_t* a0 = region.alloc(20); // first chunk
+  ASSERT_THAT(a0, g::NotNull());
+  std::fill_n(a0, 20, 0xA0);
+  EXPECT_EQ(region.countExtraChunks(), 0);
+
+  uint8_t* a1 = region.alloc(20); // second chunk
+  ASSERT_THAT(a1, g::NotNull());
+  std::fill_n(a1, 20, 0xA1);
+  EXPECT_EQ(region.countExtraChunks(), 1);
+  EXPECT_EQ(pool.countAvailable(), 1);
+  EXPECT_EQ(region.available(), 44);
+
+  uint8_t* a2 = region.allocA(50); // third chunk
+  ASSERT_THAT(a2, g::NotNull());
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(a2) % Region::ALIGNMENT, 0);
+  std::fill_n(a2, 50, 0xA2);
+  EXPECT_EQ(region.countExtraChunks(), 2);
+  EXPECT_EQ(pool.countAvailable(), 0);
+
+  EXPECT_THAT(region.alloc(65), g::IsNull()); // larger than chunk size
+  EXPECT_THAT(region.alloc(20), g::IsNull()); // pool exhausted
+  EXPECT_TRUE(region.free(a2 + 10, 40));
+  uint8_t* a3 = region.alloc(20); // fits in third chunk after free
+  EXPECT_THAT(a3, g::NotNull());
+  EXPECT_FALSE(region.free(a0, 20)); // in previous chunk
+
+  EXPECT_THAT(std::vector<uint8_t>(a0, a0 + 20), g::Each(0xA0));
+  EXPECT_THAT(std::vector<uint8_t>(a1, a1 + 20), g::Each(0xA1));
+  EXPECT_THAT(std::vector<uint8_t>(a2, a2 + 10), g::Each(0xA2));
+
+  region.reset();
+  EXPECT_EQ(region.countExtraChunks(), 0);
+  EXPECT_EQ(pool.countAvailable(), 2);
+  EXPECT_EQ(region.size(), 0);
+  EXPECT_EQ(region.available(), 32);
+  EXPECT_EQ(region.alloc(20), a0);
+}
+
+TEST(ChainedRegion, Checkpoint)
+{
+  ChunkPool pool(64, 3);
+  ChainedRegion region(pool, 32);
+
+  uint8_t* a0 = region.alloc(20);
+  ASSERT_THAT(a0, g::NotNull());
+  auto cp0 = region.mark();
+  EXPECT_THAT(region.alloc(20), g::NotNull());
+  uint8_t* a1 = region.alloc(20);
+  ASSERT_THAT(a1, g::NotNull());
+  EXPECT_EQ(region.countExtraChunks(), 1);
+
+  auto cp1 = region.mark();
+  EXPECT_THAT(region.alloc(60), g::NotNull());
+  EXPECT_THAT(region.alloc(60), g::NotNull());
+  EXPECT_EQ(region.countExtraChunks(), 3);
+
+  region.restore(cp1);
+  EXPECT_EQ(region.countExtraChunks(), 1);
+  EXPECT_EQ(pool.countAvailable(), 2);
+  EXPECT_EQ(region.alloc(4), a1 - 4);
+
+  region.restore(cp0);
+  EXPECT_EQ(region.countExtraChunks(), 0);
+  EXPECT_EQ(pool.countAvailable(), 3);
+  EXPECT_EQ(region.alloc(4), a0 - 4);
+}
+
+TEST(ChainedRegion, Enlarge)
+{
+  ChunkPool pool(64, 1);
+  ChainedRegion region(pool, 32);
+  std::vector<uint8_t> value(40);
+  EXPECT_THAT(region.alloc(20), g::NotNull());
+  EXPECT_EQ(region.available(), 12);
+  {
+    ScopedEncoder encoder(region);
+    EXPECT_FALSE(encoder.prepend(tlv::Value(value.data(), value.size())));
+  }
+
+  EXPECT_TRUE(region.enlarge());
+  EXPECT_EQ(region.countExtraChunks(), 1);
+  EXPECT_EQ(region.available(), 64);
+  {
+    ScopedEncoder encoder(region);
+    EXPECT_TRUE(encoder.prepend(tlv::Value(value.data(), value.size())));
+    EXPECT_EQ(encoder.size(), 40);
+  }
+
+  EXPECT_FALSE(region.enlarge()); // pool chunk is not larger than current chunk
+  region.reset();
+  EXPECT_THAT(region.alloc(20), g::NotNull());
+  EXPECT_TRUE(region.enlarge());
+
+  StaticRegion<64> single;
+  EXPECT_FALSE(single.enlarge());
+  EXPECT_EQ(single.available(), 64);
+}
+
+TEST(ChainedRegion, SharedPool)
+{
+  ChunkPool pool(64, 1);
+  {
+    ChainedRegion r0(pool, 16);
+    ChainedRegion r1(pool, 16);
+    EXPECT_THAT(r0.alloc(32), g::NotNull());
+    EXPECT_EQ(pool.countAvailable(), 0);
+    EXPECT_THAT(r1.alloc(32), g::IsNull());
+    EXPECT_THAT(r1.alloc(16), g::NotNull());
+
+    r0.reset();
+    EXPECT_EQ(pool.countAvailable(), 1);
+    EXPECT_THAT(r1.alloc(32), g::NotNull());
+    EXPECT_EQ(r1.countExtraChunks(), 1);
+  }
+  EXPECT_EQ(pool.countAvailable(), 1);
+}
+
+} // namespace
+} // namespace ndnph
@@ -0,0 +1,90 @@
+#include "ndnph/core/region-pool.hpp"
+
+#include "test-common.hpp"
+
+#include <set>
+
+namespace ndnph {
+namespace {
+
+TEST(RegionPool, AcquireRelease)
+{
+  RegionPool pool(100, 3);
+  EXPECT_EQ(pool.size(), 3);
+
+  std::set<Region*> regions;
+  std::vector<RegionPool::Handle> handles;
+  for (int i = 0; i < 3; ++i) {
+    RegionPool::Handle h = pool.acquire();
+    ASSERT_TRUE(h);
+    EXPECT_EQ(h->available(), 100);
+    EXPECT_THAT(h->alloc(100), g::NotNull());
+    regions.insert(h.get());
+    handles.push_back(std::move(h));
+  }
+  EXPECT_EQ(regions.size(), 3);
+  EXPECT_FALSE(pool.acquire());
+
+  Region* r1 = handles[1].get();
+  handles[1].reset();
+  EXPECT_FALSE(handles[1]);
+  RegionPool::Handle h1 = pool.acquire();
+  ASSERT_TRUE(h1);
+  EXPECT_EQ(h1.get(), r1);
+  EXPECT_EQ(h1->available(), 100);
+
+  Region* r2 = handles[2].detach();
+  handles.clear(); // releases handles[0]
+  RegionPool::Handle h0 = pool.acquire();
+  EXPECT_TRUE(h0);
+  EXPECT_FALSE(pool.acquire());
+  pool.release(r2);
+  RegionPool::Handle h2 = pool.acquire();
+  EXPECT_EQ(h2.get(), r2);
+
+  h2 = std::move(h1);
+  EXPECT_FALSE(h1);
+  EXPECT_EQ(h2.get(), r1);
+  RegionPool::Handle h3 = pool.acquire();
+  EXPECT_EQ(h3.get(), r2);
+  EXPECT_FALSE(pool.acquire());
+}
+
+TEST(RegionPool, Threads)
+{
+  RegionPool pool(64, 16);
+  std::atomic<int> nFailures(0);
+  auto worker = [&](uint8_t id) {
+    for (int i = 0; i < 20000; ++i) {
+      RegionPool::Handle h = pool.acquire();
+      if (!h) {
+        continue;
+      }
+      uint8_t* room = h->alloc(64);
+      std::fill_n(room, 64, id);
+      std::this_thread::yield();
+      if (std::count(room, room + 64, id) != 64) {
+        ++nFailures;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (uint8_t id = 1; id <= 4; ++id) {
+    threads.emplace_back(worker, id);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(nFailures, 0);
+
+  std::vector<RegionPool::Handle> handles;
+  for (int i = 0; i < 16; ++i) {
+    handles.push_back(pool.acquire());
+    EXPECT_TRUE(handles.back());
+  }
+  EXPECT_FALSE(pool.acquire());
+}
+
+} // namespace
+} // namespace ndnph
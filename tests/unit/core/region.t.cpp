@@ -2,6 +2,9 @@
 
 #include "test-common.hpp"
 
+#include <sstream>
+#include <thread>
+
 namespace ndnph {
 namespace {
 
@@ -50,6 +53,30 @@ TEST(Region, AllocFree)
   EXPECT_EQ(region.availableA(), 1);
 }
 
+TEST(Region, Checkpoint)
+{
+  StaticRegion<64> region;
+  uint8_t* a0 = region.allocA(5);
+  uint8_t* a1 = region.alloc(7);
+  ASSERT_THAT(a0, g::NotNull());
+  ASSERT_THAT(a1, g::NotNull());
+
+  auto cp0 = region.mark();
+  EXPECT_THAT(region.allocA(10), g::NotNull());
+  EXPECT_THAT(region.alloc(11), g::NotNull());
+
+  auto cp1 = region.mark();
+  EXPECT_THAT(region.alloc(region.available()), g::NotNull());
+  EXPECT_EQ(region.available(), 0);
+  region.restore(cp1);
+  EXPECT_EQ(region.size(), 5 + 3 + 10 + 7 + 11);
+
+  region.restore(cp0);
+  EXPECT_EQ(region.size(), 5 + 7);
+  EXPECT_EQ(region.alloc(1), a1 - 1);
+  EXPECT_EQ(region.allocA(1), a0 + 8);
+}
+
 class MyObj : public InRegion
 {
 public:
@@ -119,5 +146,95 @@ TEST(Region, SubRegion)
   }
 }
 
+#ifdef NDNPH_REGION_STATS
+TEST(Region, Stats)
+{
+  StaticRegion<64> region;
+  region.setStatsName("R");
+  EXPECT_THAT(region.alloc(20), g::NotNull());
+  EXPECT_THAT(region.allocA(9), g::NotNull());
+  {
+    NDNPH_REGION_TAG(region, "T");
+    EXPECT_THAT(region.alloc(40), g::IsNull());
+  }
+  EXPECT_THAT(region.allocA(40), g::IsNull());
+  region.reset();
+  EXPECT_THAT(region.alloc(8), g::NotNull());
+
+  RegionStats stats = region.getStats();
+  EXPECT_STREQ(stats.name, "R");
+  EXPECT_EQ(stats.capacity, 64);
+  EXPECT_EQ(stats.peak, 29);
+  EXPECT_EQ(stats.nAllocs, 3);
+  EXPECT_EQ(stats.nFailures, 2);
+  EXPECT_EQ(stats.lastFailureSize, 40);
+  EXPECT_THAT(stats.lastFailureTag, g::IsNull());
+
+  region.resetStats();
+  stats = region.getStats();
+  EXPECT_STREQ(stats.name, "R");
+  EXPECT_EQ(stats.peak, 8);
+  EXPECT_EQ(stats.nAllocs, 0);
+  EXPECT_EQ(stats.nFailures, 0);
+
+  {
+    NDNPH_REGION_TAG(region, "T");
+    EXPECT_THAT(region.alloc(60), g::IsNull());
+  }
+  EXPECT_STREQ(region.getStats().lastFailureTag, "T");
+
+  int nFound = 0;
+  {
+    DynamicRegion other(16);
+    other.setStatsName("O");
+    Region::forEachLive([&](const RegionStats& stats) {
+      if (stats.name != nullptr && std::strcmp(stats.name, "O") == 0) {
+        ++nFound;
+      }
+    });
+    std::ostringstream os;
+    dumpRegionStats(os);
+    EXPECT_THAT(os.str(),
+                g::HasSubstr("R capacity=64 peak=8 allocs=0 failures=1 last-failure=60@T\n"));
+    EXPECT_THAT(os.str(), g::HasSubstr("O capacity=16 peak=0 allocs=0 failures=0\n"));
+  }
+  EXPECT_EQ(nFound, 1);
+
+  nFound = 0;
+  Region::forEachLive([&](const RegionStats& stats) {
+    nFound += static_cast<int>(stats.name != nullptr && std::strcmp(stats.name, "O") == 0);
+  });
+  EXPECT_EQ(nFound, 0);
+}
+
+TEST(Region, StatsThreads)
+{
+  auto countLive = [] {
+    int n = 0;
+    Region::forEachLive([&](const RegionStats&) { ++n; });
+    return n;
+  };
+  int nBefore = countLive();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([] {
+      for (int i = 0; i < 10000; ++i) {
+        StaticRegion<16> a;
+        DynamicRegion b(16);
+        StaticRegion<16> c;
+      }
+    });
+  }
+  for (int i = 0; i < 100; ++i) {
+    countLive();
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+  EXPECT_EQ(countLive(), nBefore);
+}
+#endif // NDNPH_REGION_STATS
+
 } // namespace
 } // namespace ndnph
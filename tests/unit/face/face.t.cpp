@@ -1,10 +1,15 @@
+#include "ndnph/core/chained-region.hpp"
 #include "ndnph/face/face.hpp"
+#include "ndnph/face/transport-force-endpointid.hpp"
 #include "ndnph/keychain/null.hpp"
+#include "ndnph/packet/convention.hpp"
 
 #include "mock/bridge-fixture.hpp"
 #include "mock/mock-packet-handler.hpp"
 #include "mock/mock-transport.hpp"
 
+#include <numeric>
+
 namespace ndnph {
 namespace {
 
@@ -62,6 +67,82 @@ TEST(Face, Receive)
   ASSERT_TRUE(transport.receive(region, lp::encode(nack, 0xDE249BD0398EC80F)));
 }
 
+TEST(Face, PrefixIndex)
+{
+  MockTransport transport;
+  Face face(transport);
+  StaticRegion<4096> region;
+  ASSERT_TRUE(face.enablePrefixIndex(region, 4));
+  EXPECT_FALSE(face.enablePrefixIndex(region, 4));
+
+  auto hA = std::unique_ptr<MockPacketHandler>(new MockPacketHandler(face, 5));
+  MockPacketHandler hAB(face, 5);
+  MockPacketHandler hAB2(face, 1);
+  MockPacketHandler hOther(face, 9);
+  Name nameA = Name::parse(region, "/A");
+  Name nameAB = Name::parse(region, "/A/B");
+  Name nameC = Name::parse(region, "/C");
+  ASSERT_TRUE(face.addPrefix(*hA, nameA));
+  ASSERT_TRUE(face.addPrefix(*hA, nameC));
+  EXPECT_FALSE(face.addPrefix(*hA, nameA)); // duplicate
+  ASSERT_TRUE(face.addPrefix(hAB, Name::parse(region, "/A/B")));
+  ASSERT_TRUE(face.addPrefix(hAB2, nameAB));
+  EXPECT_FALSE(face.addPrefix(hOther, Name::parse(region, "/D"))); // full
+
+  Interest interest = region.create<Interest>();
+  ASSERT_FALSE(!interest);
+  StaticRegion<1024> nameRegion;
+  auto matchInterestName = [&nameRegion](const char* uri) {
+    return g::Property(&Interest::getName, g::Eq(Name::parse(nameRegion, uri)));
+  };
+
+  {
+    g::InSequence seq;
+    EXPECT_CALL(hAB2, processInterest(matchInterestName("/A/B/C"))).WillOnce(g::Return(false));
+    EXPECT_CALL(hAB, processInterest(matchInterestName("/A/B/C"))).WillOnce(g::Return(false));
+    EXPECT_CALL(*hA, processInterest(matchInterestName("/A/B/C"))).WillOnce(g::Return(false));
+    EXPECT_CALL(hOther, processInterest(matchInterestName("/A/B/C"))).WillOnce(g::Return(true));
+  }
+  interest.setName(Name::parse(region, "/A/B/C"));
+  ASSERT_TRUE(transport.receive(interest));
+
+  EXPECT_CALL(*hA, processInterest(matchInterestName("/C/D"))).WillOnce(g::Return(true));
+  interest.setName(Name::parse(region, "/C/D"));
+  ASSERT_TRUE(transport.receive(interest));
+
+  EXPECT_CALL(hOther, processInterest(matchInterestName("/D"))).WillOnce(g::Return(false));
+  interest.setName(Name::parse(region, "/D"));
+  ASSERT_TRUE(transport.receive(interest));
+
+  Data data = region.create<Data>();
+  ASSERT_FALSE(!data);
+  data.setName(Name::parse(region, "/A/B"));
+  {
+    g::InSequence seq;
+    EXPECT_CALL(hAB2, processData).WillOnce(g::Return(false));
+    EXPECT_CALL(hAB, processData).WillOnce(g::Return(false));
+    EXPECT_CALL(*hA, processData).WillOnce(g::Return(true));
+  }
+  ASSERT_TRUE(transport.receive(data.sign(NullKey::get())));
+
+  EXPECT_TRUE(face.removePrefix(hAB2, nameAB));
+  EXPECT_FALSE(face.removePrefix(hAB2, nameAB));
+  hA.reset(); // removes /A and /C
+  EXPECT_TRUE(face.addPrefix(hOther, Name::parse(region, "/D")));
+
+  {
+    g::InSequence seq;
+    EXPECT_CALL(hAB, processInterest(matchInterestName("/A/B"))).WillOnce(g::Return(false));
+    EXPECT_CALL(hAB2, processInterest(matchInterestName("/A/B"))).WillOnce(g::Return(false));
+  }
+  interest.setName(Name::parse(region, "/A/B"));
+  ASSERT_TRUE(transport.receive(interest));
+
+  EXPECT_CALL(hAB2, processInterest(matchInterestName("/C/D"))).WillOnce(g::Return(false));
+  interest.setName(Name::parse(region, "/C/D"));
+  ASSERT_TRUE(transport.receive(interest));
+}
+
 class TestSendHandler : public MockPacketHandler
 {
 public:
@@ -130,6 +211,244 @@ TEST(Face, Send)
   EXPECT_TRUE(transport.receive(region, lp::encode(h.request, 0xDE249BD0398EC80F), 3202));
 }
 
+TEST(Face, SendChainedRegion)
+{
+  MockTransport transport;
+  Face face(transport);
+  ChunkPool pool(2048, 1);
+  ChainedRegion region(pool, 256);
+  std::vector<uint8_t> content(1500);
+
+  Data data = region.create<Data>();
+  ASSERT_FALSE(!data);
+  data.setName(Name::parse(region, "/A"));
+  data.setContent(tlv::Value(content.data(), content.size()));
+
+  {
+    ChainedRegion other(pool, 256);
+    EXPECT_THAT(other.alloc(1024), g::NotNull()); // hold the only pool chunk
+    EXPECT_CALL(transport, doSend).Times(0);
+    EXPECT_FALSE(face.send(region, data.sign(NullKey::get()), Face::PacketInfo()));
+    EXPECT_EQ(region.countExtraChunks(), 0);
+  }
+
+  EXPECT_CALL(transport, doSend(g::SizeIs(g::Gt(content.size())), 0)).WillOnce(g::Return(true));
+  EXPECT_TRUE(face.send(region, data.sign(NullKey::get()), Face::PacketInfo()));
+  EXPECT_EQ(region.countExtraChunks(), 1);
+}
+
+TEST(Face, RetainRx)
+{
+  BridgeTransport transportA;
+  BridgeTransport transportB(1500, 512);
+  ASSERT_TRUE(transportA.begin(transportB));
+  Face faceA(transportA);
+  Face faceB(transportB);
+  MockPacketHandler hA(faceA);
+  MockPacketHandler hB(faceB);
+
+  auto sendData = [&](int i) {
+    StaticRegion<1024> region;
+    Data data = region.create<Data>();
+    data.setName(Name::parse(region, "/A").append<convention::Segment>(region, i));
+    uint8_t content[200];
+    std::fill_n(content, sizeof(content), i);
+    data.setContent(tlv::Value(content, sizeof(content)));
+    return hA.send(data.sign(NullKey::get()));
+  };
+
+  EXPECT_CALL(hB, processData).WillOnce([&](Data) {
+    EXPECT_FALSE(hB.retainCurrentPacket());
+    return true;
+  });
+  ASSERT_TRUE(sendData(0));
+  faceB.loop();
+
+  faceB.setRxInPlace(true);
+  std::vector<std::pair<Data, transport::RxBufferRef>> retained;
+  EXPECT_CALL(hB, processData)
+    .Times(NDNPH_TRANSPORT_RXQUEUELEN)
+    .WillRepeatedly([&](Data data) {
+      auto ref = hB.retainCurrentPacket();
+      EXPECT_TRUE(ref);
+      auto ref2 = ref;
+      retained.emplace_back(data, std::move(ref2));
+      return true;
+    });
+  for (int i = 0; i < NDNPH_TRANSPORT_RXQUEUELEN; ++i) {
+    ASSERT_TRUE(sendData(i));
+    faceB.loop();
+  }
+  EXPECT_FALSE(sendData(100)); // all buffers retained
+
+  ASSERT_EQ(retained.size(), NDNPH_TRANSPORT_RXQUEUELEN);
+  for (int i = 0; i < NDNPH_TRANSPORT_RXQUEUELEN; ++i) {
+    const Data& data = retained[i].first;
+    EXPECT_TRUE(data.getName()[-1].is<convention::Segment>());
+    EXPECT_EQ(data.getName()[-1].as<convention::Segment>(), i);
+    EXPECT_EQ(data.getContent().size(), 200);
+    EXPECT_THAT(std::vector<uint8_t>(data.getContent().begin(), data.getContent().end()),
+                g::Each(i));
+  }
+
+  retained.erase(retained.begin(), retained.begin() + 2);
+  EXPECT_CALL(hB, processData).Times(2).WillRepeatedly(g::Return(true));
+  EXPECT_TRUE(sendData(100));
+  EXPECT_TRUE(sendData(101));
+  EXPECT_FALSE(sendData(102));
+  faceB.loop();
+  EXPECT_TRUE(sendData(102));
+}
+
+TEST(Face, RxBurst)
+{
+  BridgeTransport transportA;
+  BridgeTransport transportB(1500, 512);
+  ASSERT_TRUE(transportA.begin(transportB));
+  Face faceA(transportA);
+  Face faceB(transportB);
+  faceB.setRxInPlace(true);
+  MockPacketHandler hA(faceA);
+  MockPacketHandler hB(faceB);
+
+  auto sendInterest = [&](int i) {
+    StaticRegion<1024> region;
+    Interest interest = region.create<Interest>();
+    interest.setName(Name::parse(region, "/A").append<convention::Segment>(region, i));
+    return hA.send(interest);
+  };
+
+  std::vector<int> received;
+  std::vector<std::pair<Interest, transport::RxBufferRef>> retained;
+  EXPECT_CALL(hB, processInterest)
+    .Times(NDNPH_TRANSPORT_RXQUEUELEN)
+    .WillRepeatedly([&](Interest interest) {
+      int i = interest.getName()[-1].as<convention::Segment>();
+      received.push_back(i);
+      if (i % 2 == 1) {
+        retained.emplace_back(interest, hB.retainCurrentPacket());
+        EXPECT_TRUE(retained.back().second);
+      }
+      return true;
+    });
+  for (int i = 0; i < NDNPH_TRANSPORT_RXQUEUELEN; ++i) {
+    ASSERT_TRUE(sendInterest(i));
+  }
+  EXPECT_FALSE(sendInterest(100)); // all buffers in RX queue
+  faceB.loop();                    // one burst
+
+  std::vector<int> expected(NDNPH_TRANSPORT_RXQUEUELEN);
+  std::iota(expected.begin(), expected.end(), 0);
+  EXPECT_THAT(received, g::ElementsAreArray(expected));
+  ASSERT_EQ(retained.size(), NDNPH_TRANSPORT_RXQUEUELEN / 2);
+  for (size_t j = 0; j < retained.size(); ++j) {
+    EXPECT_EQ(retained[j].first.getName()[-1].as<convention::Segment>(), 2 * j + 1);
+  }
+
+  // buffers of packets that were not retained are returned to the transport
+  EXPECT_CALL(hB, processInterest).WillRepeatedly(g::Return(true));
+  for (int i = 0; i < NDNPH_TRANSPORT_RXQUEUELEN / 2; ++i) {
+    EXPECT_TRUE(sendInterest(200 + i));
+  }
+  EXPECT_FALSE(sendInterest(300));
+  retained.clear();
+  faceB.loop();
+  EXPECT_TRUE(sendInterest(300));
+}
+
+TEST(Face, TxBatch)
+{
+  BridgeTransport transportA;
+  BridgeTransport transportB;
+  ASSERT_TRUE(transportA.begin(transportB));
+  Face faceA(transportA);
+  Face faceB(transportB);
+  MockPacketHandler hA(faceA);
+  MockPacketHandler hB(faceB);
+  EXPECT_FALSE(transportA.enableTxBatch(0));
+  ASSERT_TRUE(transportA.enableTxBatch(4, 256));
+
+  auto sendInterest = [&](int i, size_t appLen = 0) {
+    StaticRegion<2048> region;
+    Interest interest = region.create<Interest>();
+    interest.setName(Name::parse(region, "/A").append<convention::Segment>(region, i));
+    std::vector<uint8_t> appParams(appLen);
+    return appLen == 0 ? hA.send(interest)
+                       : hA.send(interest.parameterize(tlv::Value(appParams.data(), appLen)));
+  };
+
+  std::vector<int> received;
+  EXPECT_CALL(hB, processInterest).WillRepeatedly([&](Interest interest) {
+    received.push_back(interest.getName()[1].as<convention::Segment>());
+    return true;
+  });
+
+  // packets are deferred until faceA.loop()
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(sendInterest(i));
+  }
+  EXPECT_EQ(transportA.countQueuedTx(), 3);
+  faceB.loop();
+  EXPECT_THAT(received, g::IsEmpty());
+  faceA.loop();
+  EXPECT_EQ(transportA.countQueuedTx(), 0);
+  faceB.loop();
+  EXPECT_THAT(received, g::ElementsAre(0, 1, 2));
+  received.clear();
+
+  // full queue is flushed before enqueuing
+  for (int i = 10; i < 15; ++i) {
+    ASSERT_TRUE(sendInterest(i));
+  }
+  EXPECT_EQ(transportA.countQueuedTx(), 1);
+  faceB.loop();
+  EXPECT_THAT(received, g::ElementsAre(10, 11, 12, 13));
+  received.clear();
+
+  // long packet is sent directly, after flushing queued packets
+  ASSERT_TRUE(sendInterest(20, 400));
+  EXPECT_EQ(transportA.countQueuedTx(), 0);
+  faceB.loop();
+  EXPECT_THAT(received, g::ElementsAre(14, 20));
+  received.clear();
+
+  // disabling transmits queued packets
+  ASSERT_TRUE(sendInterest(30));
+  transportA.disableTxBatch();
+  ASSERT_TRUE(sendInterest(31));
+  EXPECT_EQ(transportA.countQueuedTx(), 0);
+  faceB.loop();
+  EXPECT_THAT(received, g::ElementsAre(30, 31));
+  received.clear();
+
+  // flush() is forwarded through ForceEndpointId wrapper
+  BridgeTransport transportC;
+  BridgeTransport transportD;
+  ASSERT_TRUE(transportC.begin(transportD));
+  ASSERT_TRUE(transportC.enableTxBatch(4, 256));
+  transport::ForceEndpointId wrapperC(transportC);
+  Face faceC(wrapperC);
+  Face faceD(transportD);
+  MockPacketHandler hC(faceC);
+  MockPacketHandler hD(faceD);
+  EXPECT_CALL(hD, processInterest).WillRepeatedly([&](Interest interest) {
+    received.push_back(interest.getName()[1].as<convention::Segment>());
+    return true;
+  });
+
+  for (int i = 40; i < 42; ++i) {
+    StaticRegion<2048> region;
+    Interest interest = region.create<Interest>();
+    interest.setName(Name::parse(region, "/A").append<convention::Segment>(region, i));
+    ASSERT_TRUE(hC.send(interest));
+  }
+  EXPECT_EQ(transportC.countQueuedTx(), 2);
+  faceC.loop();
+  EXPECT_EQ(transportC.countQueuedTx(), 0);
+  faceD.loop();
+  EXPECT_THAT(received, g::ElementsAre(40, 41));
+}
+
 class FaceFragmentationFixture : public BridgeFixture
 {
 public:
@@ -226,9 +545,17 @@ protected:
     void setupExpect()
     {
       EXPECT_CALL(*this, processData).WillOnce([this](Data data) {
+        Region& region = regionOf(data);
+        if (exhaustRegion) {
+          region.alloc(region.available());
+        }
         matchPitToken = m_pending.matchPitToken();
-        matchInterest = m_pending.match(data, interest);
         matchName = m_pending.match(data, name, canBePrefix);
+        if (clobberRegion) {
+          size_t size = region.available();
+          std::fill_n(region.alloc(size), size, 0x00);
+        }
+        matchInterest = m_pending.match(data, interest);
         return true;
       });
     }
@@ -237,6 +564,8 @@ protected:
     Interest interest;
     Name name;
     bool canBePrefix = false;
+    bool exhaustRegion = false; ///< fill packet region before match()
+    bool clobberRegion = false; ///< overwrite free space in packet region after match()
 
     bool matchPitToken = false;
     bool matchInterest = false;
@@ -325,6 +654,46 @@ TEST_F(FacePendingFixture, DigestMatch)
   EXPECT_TRUE(h.matchName);
 }
 
+TEST_F(FacePendingFixture, DigestMatchLazy)
+{
+  auto data1 = pRegion.create<Data>();
+  assert(!!data1);
+  data1.setName(Name::parse(pRegion, "/A/B"));
+  data.decodeFrom(data1.sign(NullKey::get()));
+
+  interest.setName(data.getFullName(cRegion));
+
+  face.setLazyDecode(true);
+  setupRespond();
+  h.interest = interest;
+  h.name = interest.getName();
+  h.canBePrefix = false;
+  h.clobberRegion = true;
+  h.send(interest);
+
+  EXPECT_TRUE(h.matchPitToken);
+  EXPECT_TRUE(h.matchName);
+  EXPECT_TRUE(h.matchInterest); // lazily decoded fields survive match()
+}
+
+TEST_F(FacePendingFixture, MatchExhaustedRegion)
+{
+  interest.setName(Name::parse(cRegion, "/A"));
+  interest.setCanBePrefix(true);
+  data.setName(Name::parse(pRegion, "/A/B"));
+
+  setupRespond();
+  h.interest = interest;
+  h.name = interest.getName();
+  h.canBePrefix = true;
+  h.exhaustRegion = true;
+  h.send(interest);
+
+  EXPECT_TRUE(h.matchPitToken);
+  EXPECT_FALSE(h.matchName); // no room for temporary Interest
+  EXPECT_TRUE(h.matchInterest);
+}
+
 TEST_F(FacePendingFixture, MismatchData)
 {
   interest.setName(Name::parse(cRegion, "/A"));
@@ -0,0 +1,219 @@
+#include "ndnph/face/pending-interest-table.hpp"
+#include "ndnph/keychain/null.hpp"
+
+#include "test-common.hpp"
+
+namespace ndnph {
+namespace {
+
+using Entry = PendingInterestTable::Entry;
+
+TEST(PendingInterestTable, Token)
+{
+  StaticRegion<4096> region;
+  PendingInterestTable pit(region, 2);
+  ASSERT_FALSE(!pit);
+  EXPECT_EQ(pit.capacity(), 2);
+
+  Name name = Name::parse(region, "/A");
+  Entry* e0 = pit.insert(name, 1000);
+  ASSERT_THAT(e0, g::NotNull());
+  Entry* e1 = pit.insert(name, 1000);
+  ASSERT_THAT(e1, g::NotNull());
+  EXPECT_THAT(pit.insert(name, 1000), g::IsNull());
+  EXPECT_EQ(pit.size(), 2);
+  EXPECT_TRUE(!e0->getName());
+
+  uint64_t token0 = e0->getPitToken();
+  EXPECT_NE(token0, e1->getPitToken());
+  EXPECT_EQ(pit.find(token0), e0);
+  EXPECT_EQ(pit.find(e1->getPitToken()), e1);
+  EXPECT_THAT(pit.find(0), g::IsNull());
+  EXPECT_THAT(pit.find(token0 ^ 0x0001000000000000), g::IsNull());
+
+  Data data = region.create<Data>();
+  ASSERT_FALSE(!data);
+  data.setName(Name::parse(region, "/B"));
+  EXPECT_EQ(pit.findData(token0, data), e0); // no name storage, name not checked
+
+  pit.erase(e0);
+  EXPECT_EQ(pit.size(), 1);
+  EXPECT_THAT(pit.find(token0), g::IsNull());
+  Entry* e2 = pit.insert(name, 1000);
+  ASSERT_EQ(e2, e0); // slot reused
+  EXPECT_NE(e2->getPitToken(), token0);
+  EXPECT_THAT(pit.find(token0), g::IsNull());
+  EXPECT_EQ(pit.find(e2->getPitToken()), e2);
+}
+
+TEST(PendingInterestTable, Name)
+{
+  StaticRegion<4096> region;
+  PendingInterestTable pit(region, 4, 16);
+  ASSERT_FALSE(!pit);
+
+  StaticRegion<1024> temp;
+  Entry* eAB = pit.insert(Name::parse(temp, "/A/B"), 1000);
+  ASSERT_THAT(eAB, g::NotNull());
+  Entry* eC = pit.insert(Name::parse(temp, "/C"), 1000);
+  ASSERT_THAT(eC, g::NotNull());
+  EXPECT_THAT(pit.insert(Name::parse(temp, "/LONG-NAME-COMPONENT"), 1000), g::IsNull());
+  temp.reset();
+  EXPECT_EQ(test::toString(eAB->getName()), "/8=A/8=B");
+
+  EXPECT_EQ(pit.findName(Name::parse(region, "/C")), eC);
+  EXPECT_THAT(pit.findName(Name::parse(region, "/A")), g::IsNull());
+
+  Data data = region.create<Data>();
+  ASSERT_FALSE(!data);
+  data.setName(Name::parse(region, "/A/B/1"));
+  EXPECT_EQ(pit.findData(eAB->getPitToken(), data), eAB);
+  EXPECT_EQ(pit.findData(0, data), eAB);                 // name fallback
+  EXPECT_EQ(pit.findData(eC->getPitToken(), data), eAB); // name mismatch on token
+  data.setName(Name::parse(region, "/A"));
+  EXPECT_THAT(pit.findData(eAB->getPitToken(), data), g::IsNull());
+
+  Interest interest = region.create<Interest>();
+  ASSERT_FALSE(!interest);
+  interest.setName(Name::parse(region, "/C"));
+  Nack nack = Nack::create(interest, NackReason::NoRoute);
+  ASSERT_FALSE(!nack);
+  EXPECT_EQ(pit.findNack(eC->getPitToken(), nack), eC);
+  EXPECT_EQ(pit.findNack(0, nack), eC);
+  EXPECT_EQ(pit.findNack(eAB->getPitToken(), nack), eC);
+
+  // newer entry with same name takes over name lookup
+  Entry* eC2 = pit.insert(Name::parse(region, "/C"), 1000);
+  ASSERT_THAT(eC2, g::NotNull());
+  EXPECT_EQ(pit.findName(Name::parse(region, "/C")), eC2);
+  pit.erase(eC);
+  EXPECT_EQ(pit.findName(Name::parse(region, "/C")), eC2);
+  pit.erase(eC2);
+  EXPECT_THAT(pit.findName(Name::parse(region, "/C")), g::IsNull());
+}
+
+TEST(PendingInterestTable, SameName)
+{
+  StaticRegion<4096> region;
+  PendingInterestTable pit(region, 4, 16);
+  ASSERT_FALSE(!pit);
+
+  Name name = Name::parse(region, "/A");
+  Entry* e0 = pit.insert(name, 1000);
+  ASSERT_THAT(e0, g::NotNull());
+  Entry* e1 = pit.insert(name, 1000);
+  ASSERT_THAT(e1, g::NotNull());
+  Entry* e2 = pit.insert(name, 1000);
+  ASSERT_THAT(e2, g::NotNull());
+  EXPECT_EQ(pit.findName(name), e2);
+
+  Data data = region.create<Data>();
+  ASSERT_FALSE(!data);
+  data.setName(Name::parse(region, "/A/1"));
+  Interest interest = region.create<Interest>();
+  ASSERT_FALSE(!interest);
+  interest.setName(name);
+  Nack nack = Nack::create(interest, NackReason::NoRoute);
+  ASSERT_FALSE(!nack);
+
+  // erasing an older entry keeps the newest reachable
+  pit.erase(e1);
+  EXPECT_EQ(pit.findName(name), e2);
+
+  // erasing the newest entry makes the next older entry reachable
+  pit.erase(e2);
+  EXPECT_EQ(pit.findName(name), e0);
+  EXPECT_EQ(pit.findData(0, data), e0);
+  EXPECT_EQ(pit.findNack(0, nack), e0);
+
+  // name buffers of erased entries may be reused
+  Entry* eB = pit.insert(Name::parse(region, "/B"), 1000);
+  ASSERT_THAT(eB, g::NotNull());
+  Entry* eC = pit.insert(Name::parse(region, "/C"), 1000);
+  ASSERT_THAT(eC, g::NotNull());
+  EXPECT_EQ(pit.findName(name), e0);
+  EXPECT_EQ(pit.findName(Name::parse(region, "/B")), eB);
+
+  pit.erase(e0);
+  EXPECT_THAT(pit.findName(name), g::IsNull());
+}
+
+TEST(PendingInterestTable, Timeout)
+{
+  StaticRegion<4096> region;
+  PendingInterestTable pit(region, 8);
+  ASSERT_FALSE(!pit);
+  Name name = Name::parse(region, "/A");
+
+  std::vector<int> expired;
+  auto onTimeout = [](void* arg, Entry& entry) {
+    static_cast<std::vector<int>*>(arg)->push_back(
+      port::Clock::sub(entry.getExpiry(), entry.getSendTime()));
+  };
+  auto now = port::Clock::now();
+  ASSERT_THAT(pit.insert(name, 3000, onTimeout, &expired), g::NotNull());
+  ASSERT_THAT(pit.insert(name, 1000, onTimeout, &expired), g::NotNull());
+  Entry* e5 = pit.insert(name, 5000, onTimeout, &expired);
+  ASSERT_THAT(e5, g::NotNull());
+  ASSERT_THAT(pit.insert(name, 2000, onTimeout, &expired), g::NotNull());
+  ASSERT_THAT(pit.insert(name, 4000), g::NotNull());
+  pit.erase(e5);
+
+  EXPECT_EQ(pit.processTimeouts(now), 0);
+  EXPECT_EQ(pit.processTimeouts(port::Clock::add(now, 2500)), 2);
+  EXPECT_THAT(expired, g::ElementsAre(1000, 2000));
+  EXPECT_EQ(pit.size(), 2);
+  EXPECT_EQ(pit.processTimeouts(port::Clock::add(now, 9000)), 2);
+  EXPECT_THAT(expired, g::ElementsAre(1000, 2000, 3000));
+  EXPECT_EQ(pit.size(), 0);
+
+  // callback may erase and reinsert
+  struct Ctx
+  {
+    PendingInterestTable* pit;
+    Name name;
+    int nRetx;
+  } ctx{ &pit, name, 0 };
+  auto retx = [](void* arg, Entry& entry) {
+    auto ctx = static_cast<Ctx*>(arg);
+    ctx->pit->erase(&entry);
+    ++ctx->nRetx;
+    ctx->pit->insert(ctx->name, 1000); // reuses the slot
+  };
+  ASSERT_THAT(pit.insert(name, 0, retx, &ctx), g::NotNull());
+  EXPECT_EQ(pit.processTimeouts(port::Clock::add(now, 500)), 1);
+  EXPECT_EQ(ctx.nRetx, 1);
+  EXPECT_EQ(pit.size(), 1);
+}
+
+TEST(PendingInterestTable, Many)
+{
+  DynamicRegion region(4 << 20);
+  const uint32_t capacity = 4000;
+  PendingInterestTable pit(region, capacity, 32);
+  ASSERT_FALSE(!pit);
+
+  std::vector<Entry*> entries;
+  std::vector<std::string> uris;
+  for (uint32_t i = 0; i < capacity; ++i) {
+    uris.push_back("/P/" + std::to_string(i));
+    Entry* entry = pit.insert(Name::parse(region, uris.back().data()), 1000 + i % 7);
+    ASSERT_THAT(entry, g::NotNull());
+    entries.push_back(entry);
+  }
+  EXPECT_EQ(pit.size(), capacity);
+
+  Data data = region.create<Data>();
+  ASSERT_FALSE(!data);
+  for (uint32_t i = 0; i < capacity; i += 3) {
+    data.setName(Name::parse(region, uris[i].data()));
+    ASSERT_EQ(pit.findData(entries[i]->getPitToken(), data), entries[i]);
+    pit.erase(entries[i]);
+  }
+  EXPECT_EQ(pit.processTimeouts(port::Clock::add(port::Clock::now(), 10000)),
+            capacity - (capacity + 2) / 3);
+  EXPECT_EQ(pit.size(), 0);
+}
+
+} // namespace
+} // namespace ndnph
@@ -0,0 +1,63 @@
+#include "ndnph/face/rtt-estimator.hpp"
+
+#include "test-common.hpp"
+
+namespace ndnph {
+namespace {
+
+TEST(RttEstimator, Rfc6298)
+{
+  RttEstimator rtt;
+  EXPECT_FALSE(rtt.hasMeasurement());
+  EXPECT_EQ(rtt.getSrtt(), -1);
+  EXPECT_EQ(rtt.getRto(), 1000);
+
+  rtt.addMeasurement(100);
+  EXPECT_TRUE(rtt.hasMeasurement());
+  EXPECT_EQ(rtt.getSrtt(), 100);
+  EXPECT_EQ(rtt.getRttVar(), 50);
+  EXPECT_EQ(rtt.getRto(), 300);
+
+  rtt.addMeasurement(200);
+  EXPECT_EQ(rtt.getSrtt(), 112);
+  EXPECT_EQ(rtt.getRttVar(), 62);
+  EXPECT_EQ(rtt.getRto(), 362);
+
+  rtt.backoff();
+  EXPECT_EQ(rtt.getRto(), 724);
+  rtt.backoff();
+  EXPECT_EQ(rtt.getRto(), 1448);
+
+  rtt.addMeasurement(112); // cancels backoff
+  EXPECT_EQ(rtt.getSrtt(), 112);
+  EXPECT_LT(rtt.getRto(), 362);
+}
+
+TEST(RttEstimator, Bounds)
+{
+  RttEstimator::Options opts;
+  opts.initRto = 50;
+  opts.minRto = 100;
+  opts.maxRto = 500;
+  RttEstimator rtt(opts);
+  EXPECT_EQ(rtt.getRto(), 100);
+
+  for (int i = 0; i < 20; ++i) {
+    rtt.addMeasurement(1);
+  }
+  EXPECT_EQ(rtt.getSrtt(), 1);
+  EXPECT_EQ(rtt.getRto(), 100);
+
+  for (int i = 0; i < 5; ++i) {
+    rtt.backoff();
+  }
+  EXPECT_EQ(rtt.getRto(), 500);
+
+  auto now = port::Clock::now();
+  rtt.addMeasurement(port::Clock::add(now, -300), now);
+  EXPECT_EQ(rtt.getSrtt(), 38);
+  EXPECT_EQ(rtt.getRto(), 339);
+}
+
+} // namespace
+} // namespace ndnph
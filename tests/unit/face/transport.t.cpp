@@ -1,3 +1,5 @@
+#include "ndnph/app/ping-client.hpp"
+#include "ndnph/app/ping-server.hpp"
 #include "ndnph/face/bridge-transport.hpp"
 #include "ndnph/face/transport-force-endpointid.hpp"
 #include "ndnph/port/transport/port.hpp"
@@ -65,21 +67,25 @@ TEST(Transport, ForceEndpointId)
   TransportTest(faceB, faceA).run().check();
 }
 
+uint16_t
+findFreeUdpPort()
+{
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  EXPECT_GE(fd, 0);
+  sockaddr_in laddr = {};
+  laddr.sin_family = AF_INET;
+  laddr.sin_addr.s_addr = INADDR_ANY;
+  socklen_t laddrLen = sizeof(laddr);
+  EXPECT_EQ(bind(fd, reinterpret_cast<sockaddr*>(&laddr), laddrLen), 0);
+  EXPECT_EQ(getsockname(fd, reinterpret_cast<sockaddr*>(&laddr), &laddrLen), 0);
+  EXPECT_EQ(close(fd), 0);
+  return ntohs(laddr.sin_port);
+}
+
 TEST(Transport, UdpUnicast)
 {
-  uint16_t freePort = 0;
-  {
-    int fd = socket(AF_INET, SOCK_DGRAM, 0);
-    ASSERT_GE(fd, 0);
-    sockaddr_in laddr = {};
-    laddr.sin_family = AF_INET;
-    laddr.sin_addr.s_addr = INADDR_ANY;
-    socklen_t laddrLen = sizeof(laddr);
-    ASSERT_EQ(bind(fd, reinterpret_cast<sockaddr*>(&laddr), laddrLen), 0);
-    ASSERT_EQ(getsockname(fd, reinterpret_cast<sockaddr*>(&laddr), &laddrLen), 0);
-    ASSERT_EQ(close(fd), 0);
-    freePort = ntohs(laddr.sin_port);
-  }
+  uint16_t freePort = findFreeUdpPort();
+  ASSERT_NE(freePort, 0);
 
   UdpUnicastTransport transportA;
   UdpUnicastTransport transportB;
@@ -94,6 +100,87 @@ TEST(Transport, UdpUnicast)
   Face faceA(transportA);
   Face faceB(transportB);
   TransportTest(faceA, faceB).run().check();
+
+  auto runBurst = [&] {
+    TransportTest burst(faceA, faceB, 3 * NDNPH_TRANSPORT_RXQUEUELEN);
+    for (uint32_t i = 0; i < burst.nPkts; ++i) {
+      burst.txA.sendOne(1000 + i);
+    }
+    faceA.loop();
+    EXPECT_EQ(transportA.countQueuedTx(), 0);
+    port::Clock::sleep(50);
+
+    faceB.loop();
+    EXPECT_EQ(burst.rxB.received.size(), NDNPH_TRANSPORT_RXQUEUELEN);
+    for (int i = 0; i < 10 && burst.rxB.received.size() < burst.nPkts; ++i) {
+      faceB.loop();
+    }
+    EXPECT_EQ(burst.txA.nSendSuccess, burst.nPkts);
+    EXPECT_EQ(burst.rxB.received.size(), burst.nPkts);
+  };
+
+  // burst TX and RX
+  ASSERT_TRUE(transportA.enableTxBatch(4 * NDNPH_TRANSPORT_RXQUEUELEN));
+  runBurst();
+
+  // GSO
+  if (!transportA.enableGso()) {
+    return;
+  }
+  runBurst();
+
+  // GSO and GRO
+  ASSERT_TRUE(transportB.enableGro());
+  runBurst();
+}
+
+TEST(Transport, UdpSharded)
+{
+  uint16_t freePort = findFreeUdpPort();
+  ASSERT_NE(freePort, 0);
+
+  StaticRegion<1024> region;
+  Name prefix = Name::parse(region, "/ping");
+
+  UdpShardedListener listener(2);
+  ASSERT_EQ(listener.size(), 2);
+  ASSERT_TRUE(listener.begin(freePort, true));
+  std::atomic_bool stop(false);
+  std::atomic_int nStarted(0);
+  std::thread serverThread([&] {
+    listener.run(
+      [&](Face& face, size_t) {
+        ++nStarted;
+        return std::unique_ptr<PingServer>(new PingServer(prefix, face));
+      },
+      stop);
+  });
+
+  static constexpr int nClients = 4;
+  std::unique_ptr<UdpUnicastTransport> transports[nClients];
+  std::unique_ptr<Face> faces[nClients];
+  std::unique_ptr<PingClient> clients[nClients];
+  for (int i = 0; i < nClients; ++i) {
+    transports[i].reset(new UdpUnicastTransport());
+    ASSERT_TRUE(transports[i]->beginTunnel({ 127, 0, 0, 1 }, freePort));
+    faces[i].reset(new Face(*transports[i]));
+    clients[i].reset(new PingClient(prefix, *faces[i], 5));
+  }
+  for (int t = 0; t < 300; ++t) {
+    for (auto& face : faces) {
+      face->loop();
+    }
+    port::Clock::sleep(1);
+  }
+
+  stop = true;
+  serverThread.join();
+  EXPECT_EQ(nStarted, 2);
+  for (auto& client : clients) {
+    auto cnt = client->readCounters();
+    EXPECT_GT(cnt.nRxData, 0);
+    EXPECT_GE(cnt.nRxData + 2, cnt.nTxInterests);
+  }
 }
 
 } // namespace
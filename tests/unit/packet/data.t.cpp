@@ -100,5 +100,92 @@ TEST(Data, EncodeFull)
   }
 }
 
+TEST(Data, EncodeInsufficientRoom)
+{
+  StaticRegion<1024> region;
+  Data data = region.create<Data>();
+  ASSERT_FALSE(!data);
+  data.setName(Name::parse(region, "/A/B"));
+  std::vector<uint8_t> content(100);
+  data.setContent(tlv::Value(content.data(), content.size()));
+
+  MockPrivateKey<32> key;
+  EXPECT_CALL(key, updateSigInfo).Times(g::AnyNumber());
+  EXPECT_CALL(key, doSign).Times(0);
+  std::vector<uint8_t> buf(120);
+  Encoder encoder(buf.data(), buf.size());
+  EXPECT_FALSE(encoder.prepend(data.sign(key)));
+}
+
+TEST(Data, LazyDecode)
+{
+  StaticRegion<2048> region;
+  auto wire = test::fromHex("0621 name=0706080141080142 metainfo=1408 contenttype=180101 "
+                            "finalblock=1A03080142 content=1502C0C1"
+                            "siginfo=16031B0110 sigvalue=1704F0F1F2F3");
+
+  Data data = region.create<Data>();
+  ASSERT_FALSE(!data);
+  data.setLazyDecode(true);
+  size_t regionSize = region.size();
+  ASSERT_TRUE(Decoder(wire.data(), wire.size()).decode(data));
+  EXPECT_EQ(region.size(), regionSize); // no DataSigned yet
+  EXPECT_EQ(data.getName(), Name::parse(region, "/A/B"));
+  regionSize = region.size();
+
+  EXPECT_EQ(data.getContentType(), 0x01);
+  EXPECT_GT(region.size(), regionSize);
+  EXPECT_EQ(data.getIsFinalBlock(), true);
+  tlv::Value content = data.getContent();
+  EXPECT_THAT(std::vector<uint8_t>(content.begin(), content.end()), g::ElementsAre(0xC0, 0xC1));
+  ASSERT_THAT(data.getSigInfo(), g::NotNull());
+  EXPECT_EQ(data.getSigInfo()->sigType, 0x10);
+  EXPECT_TRUE(data.finishDecode());
+
+  Data lazy2 = region.create<Data>();
+  lazy2.setLazyDecode(true);
+  ASSERT_TRUE(Decoder(wire.data(), wire.size()).decode(lazy2));
+  lazy2.setFreshnessPeriod(1000); // setter decodes other fields first
+  EXPECT_EQ(lazy2.getFreshnessPeriod(), 1000);
+  EXPECT_EQ(lazy2.getContentType(), 0x01);
+  {
+    MockPublicKey key;
+    EXPECT_CALL(key, doVerify(g::ElementsAreArray(&wire[2], &wire[29]),
+                              g::ElementsAreArray(&wire[31], &wire[35])))
+      .WillOnce(g::Return(true));
+    EXPECT_TRUE(lazy2.verify(key));
+  }
+
+  wire[12] = 0x01; // ContentType TLV-TYPE becomes critical and unrecognized
+  Data bad = region.create<Data>();
+  bad.setLazyDecode(true);
+  ASSERT_TRUE(Decoder(wire.data(), wire.size()).decode(bad));
+  EXPECT_FALSE(bad.finishDecode());
+  EXPECT_THAT(bad.getSigInfo(), g::IsNull());
+  MockPublicKey key;
+  EXPECT_CALL(key, doVerify).Times(0);
+  EXPECT_FALSE(bad.verify(key));
+  EXPECT_FALSE(bad.finishDecode()); // failure is sticky
+
+  wire[12] = 0x18;
+  wire[29] = 0x01; // SignatureValue TLV-TYPE becomes critical and unrecognized
+  Data badSig = region.create<Data>();
+  ASSERT_FALSE(!badSig);
+  badSig.setLazyDecode(true);
+  ASSERT_TRUE(Decoder(wire.data(), wire.size()).decode(badSig));
+  EXPECT_EQ(badSig.getContent().size(), 0); // partially decoded fields are reset
+  EXPECT_EQ(badSig.getContentType(), ContentType::Blob);
+  EXPECT_FALSE(badSig.getIsFinalBlock());
+  EXPECT_FALSE(badSig.finishDecode());
+  EXPECT_THAT(badSig.getSigInfo(), g::IsNull());
+  Data eagerSig = region.create<Data>();
+  EXPECT_FALSE(Decoder(wire.data(), wire.size()).decode(eagerSig));
+
+  wire[2] = 0x08; // Name is not the first element
+  Data badName = region.create<Data>();
+  badName.setLazyDecode(true);
+  EXPECT_FALSE(Decoder(wire.data(), wire.size()).decode(badName));
+}
+
 } // namespace
 } // namespace ndnph
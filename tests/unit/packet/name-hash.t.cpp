@@ -0,0 +1,137 @@
+#include "ndnph/packet/name-hash.hpp"
+
+#include "test-common.hpp"
+
+#include <random>
+
+namespace ndnph {
+namespace {
+
+TEST(NameHash, Prefixes)
+{
+  StaticRegion<1024> region;
+  Name name = Name::parse(region, "/A/BCDEFGHIJKLMN/O/P");
+  ASSERT_FALSE(!name);
+
+  uint64_t hashes[8];
+  size_t lengths[8];
+  ASSERT_EQ(NameHash::prefixes(name, hashes, 8, lengths), 4);
+  for (size_t i = 0; i < 4; ++i) {
+    Name prefix = name.getPrefix(i + 1);
+    EXPECT_EQ(hashes[i], NameHash::of(prefix));
+    EXPECT_EQ(lengths[i], prefix.length());
+  }
+  EXPECT_EQ(hashes[3], NameHash::of(name));
+  EXPECT_NE(hashes[0], hashes[1]);
+  EXPECT_NE(NameHash::of(Name::parse(region, "/AB")), NameHash::of(Name::parse(region, "/A/B")));
+
+  EXPECT_EQ(NameHash::prefixes(name, hashes, 2), 2);
+  EXPECT_EQ(NameHash::prefixes(Name(), hashes, 8), 0);
+}
+
+TEST(NameHashMap, Basic)
+{
+  StaticRegion<4096> region;
+  NameHashMap<int> map(region, 3);
+  ASSERT_FALSE(!map);
+  EXPECT_EQ(map.capacity(), 3);
+  EXPECT_EQ(map.size(), 0);
+
+  Name a = Name::parse(region, "/A");
+  Name ab = Name::parse(region, "/A/B");
+  Name abc = Name::parse(region, "/A/B/C");
+  Name d = Name::parse(region, "/D");
+  EXPECT_THAT(map.find(a), g::IsNull());
+  EXPECT_FALSE(map.erase(a));
+
+  ASSERT_THAT(map.insert(a, 1), g::NotNull());
+  ASSERT_THAT(map.insert(abc, 3), g::NotNull());
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(*map.insert(a, 10), 10); // overwrite
+  EXPECT_EQ(map.size(), 2);
+  ASSERT_THAT(map.insert(ab, 2), g::NotNull());
+  EXPECT_THAT(map.insert(d, 4), g::IsNull()); // full
+  EXPECT_EQ(map.size(), 3);
+
+  ASSERT_THAT(map.find(Name::parse(region, "/A/B")), g::NotNull());
+  EXPECT_EQ(*map.find(Name::parse(region, "/A/B")), 2);
+
+  uint64_t hashes[4];
+  size_t lengths[4];
+  size_t n = NameHash::prefixes(abc, hashes, 4, lengths);
+  ASSERT_EQ(n, 3);
+  EXPECT_EQ(*map.findPrefix(abc, hashes[0], lengths[0]), 10);
+  EXPECT_EQ(*map.findPrefix(abc, hashes[1], lengths[1]), 2);
+  EXPECT_EQ(*map.findPrefix(abc, hashes[2], lengths[2]), 3);
+
+  int sum = 0;
+  map.forEach([&](const Name&, int& value) { sum += value; });
+  EXPECT_EQ(sum, 15);
+
+  EXPECT_TRUE(map.erase(ab));
+  EXPECT_FALSE(map.erase(ab));
+  EXPECT_THAT(map.find(ab), g::IsNull());
+  EXPECT_EQ(*map.find(a), 10);
+  EXPECT_EQ(*map.find(abc), 3);
+  EXPECT_THAT(map.insert(d, 4), g::NotNull());
+
+  int* found = map.findIf(NameHash::of(abc), [](int value) { return value == 3; });
+  ASSERT_THAT(found, g::NotNull());
+  EXPECT_THAT(map.findIf(NameHash::of(abc), [](int value) { return value == 4; }), g::IsNull());
+  map.erase(found);
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_THAT(map.find(abc), g::IsNull());
+
+  map.clear();
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_THAT(map.find(a), g::IsNull());
+}
+
+TEST(NameHashMap, Churn)
+{
+  DynamicRegion region(1 << 20);
+  const int nNames = 500;
+  std::vector<Name> names;
+  for (int i = 0; i < nNames; ++i) {
+    names.push_back(Name::parse(region, ("/P/" + std::to_string(i)).data()));
+  }
+
+  NameHashMap<int> map(region, nNames);
+  ASSERT_FALSE(!map);
+  std::vector<bool> present(nNames, false);
+  std::mt19937 rng(1);
+  for (int round = 0; round < 20000; ++round) {
+    int i = rng() % nNames;
+    if (present[i]) {
+      ASSERT_TRUE(map.erase(names[i]));
+    } else {
+      ASSERT_THAT(map.insert(names[i], i), g::NotNull());
+    }
+    present[i] = !present[i];
+  }
+
+  size_t count = 0;
+  for (int i = 0; i < nNames; ++i) {
+    int* value = map.find(names[i]);
+    if (present[i]) {
+      ASSERT_THAT(value, g::NotNull());
+      EXPECT_EQ(*value, i);
+      ++count;
+    } else {
+      EXPECT_THAT(value, g::IsNull());
+    }
+  }
+  EXPECT_EQ(map.size(), count);
+}
+
+TEST(NameHashMap, AllocError)
+{
+  StaticRegion<64> region;
+  NameHashMap<int> map(region, 100);
+  EXPECT_TRUE(!map);
+  EXPECT_THAT(map.find(Name()), g::IsNull());
+  EXPECT_THAT(map.insert(Name(), 1), g::IsNull());
+}
+
+} // namespace
+} // namespace ndnph
@@ -153,6 +153,99 @@ TEST(Name, Slice)
   EXPECT_TRUE(!name.getPrefix(-9)); // last<0
 }
 
+TEST(Name, RandomAccess)
+{
+  StaticRegion<2048> region;
+  std::vector<uint8_t> longValue(300, 0xBB);
+  Name name = Name::parse(region, "/A/BB/CCC/DDDD");
+  name = name.append(region, { Component(region, longValue.size(), longValue.data()),
+                               Component::parse(region, "F"), Component::parse(region, "GG"),
+                               Component::parse(region, "HHH") });
+  ASSERT_THAT(name, g::SizeIs(8));
+
+  std::vector<Component> comps;
+  for (auto comp : name) {
+    comps.push_back(comp);
+  }
+  ASSERT_EQ(comps.size(), 8);
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(name[i], comps[i]) << i;
+    EXPECT_EQ(name[i - 8], comps[i]) << i;
+  }
+
+  for (int first = 0; first < 8; ++first) {
+    for (int last = first + 1; last <= 8; ++last) {
+      Name sub = name.slice(first, last);
+      ASSERT_THAT(sub, g::SizeIs(last - first));
+      EXPECT_EQ(sub.value(), comps[first].tlv());
+      for (int i = 0; i < last - first; ++i) {
+        EXPECT_EQ(sub[i], comps[first + i]) << first << ' ' << last << ' ' << i;
+      }
+      Name sub2 = sub.slice(1);
+      if (last - first > 1) {
+        EXPECT_EQ(sub2[-1], comps[last - 1]);
+      }
+    }
+  }
+
+  Name decoded(name.value(), name.length());
+  EXPECT_EQ(decoded[5], comps[5]);
+  EXPECT_EQ(decoded.getPrefix(-1)[-1], comps[6]);
+}
+
+TEST(Name, RandomAccessLong)
+{
+  // Name TLV-VALUE is longer than 65535 octets, so that offsets do not fit in the index
+  std::vector<uint8_t> wire;
+  auto appendComp = [&wire](size_t length, uint8_t octet) {
+    wire.insert(wire.end(), { 0x08, 0xFD, static_cast<uint8_t>(length >> 8),
+                              static_cast<uint8_t>(length) });
+    wire.insert(wire.end(), length, octet);
+  };
+  appendComp(40000, 0xA0);
+  appendComp(40000, 0xA1);
+  appendComp(1, 0xA2);
+  appendComp(1, 0xA3);
+  appendComp(1, 0xA4);
+
+  Name name(wire.data(), wire.size());
+  ASSERT_THAT(name, g::SizeIs(5));
+  std::vector<Component> comps;
+  for (auto comp : name) {
+    comps.push_back(comp);
+  }
+  ASSERT_EQ(comps.size(), 5);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(name[i], comps[i]) << i;
+    EXPECT_EQ(name[i].value()[0], 0xA0 + i) << i;
+  }
+
+  Name sub = name.slice(2);
+  ASSERT_THAT(sub, g::SizeIs(3));
+  EXPECT_EQ(sub.value(), comps[2].tlv());
+  EXPECT_EQ(sub[1], comps[3]);
+  EXPECT_EQ(sub[-1], comps[4]);
+  EXPECT_EQ(name.getPrefix(-1)[-1], comps[3]);
+  EXPECT_EQ(name.slice(1, 4)[2], comps[3]);
+}
+
+TEST(Name, LastComponent)
+{
+  StaticRegion<1024> region;
+  Name parsed = Name::parse(region, "/A/BB/CCC/DDDD/E/F/G/H/I/J");
+  EXPECT_EQ(parsed[-1], Component::parse(region, "J"));
+  EXPECT_EQ(parsed.getPrefix(-1)[-1], Component::parse(region, "I"));
+  EXPECT_EQ(parsed.append(region, {})[-1], Component::parse(region, "J"));
+
+  std::vector<uint8_t> wire(parsed.value(), parsed.value() + parsed.length());
+  Name decoded(wire.data(), wire.size());
+  ASSERT_THAT(decoded, g::SizeIs(10));
+  // last component is located without walking over preceding components
+  wire[1] = 0x00;
+  EXPECT_EQ(decoded[-1], Component::parse(region, "J"));
+  EXPECT_EQ(decoded[9], Component::parse(region, "J"));
+}
+
 TEST(Name, Append)
 {
   StaticRegion<1024> region;
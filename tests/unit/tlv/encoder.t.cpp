@@ -160,5 +160,49 @@ TEST(Encoder, Prepend)
                                                 )));
 }
 
+TEST(Encoder, Gather)
+{
+  uint8_t buf[60];
+  Encoder encoder(buf, sizeof(buf));
+  EncoderGather gather(4);
+  encoder.setGather(&gather);
+
+  std::vector<uint8_t> small({ 0xB0, 0xB1 });
+  std::vector<uint8_t> large({ 0xD0, 0xD1, 0xD2, 0xD3, 0xD4 });
+
+  bool ok = encoder.prependTlv(0xC0, [&](Encoder& encoder) {
+    encoder.prependRef(large.data(), large.size());
+  });
+  ok = ok && encoder.prependTlv(0xC1, [&](Encoder& encoder) {
+    encoder.prependRef(small.data(), small.size());
+  });
+  ok = ok && encoder.prependTlv(0xC2, [&](Encoder& encoder) {
+    encoder.prependRef(large.data(), large.size());
+  });
+  ASSERT_TRUE(ok);
+  EXPECT_EQ(encoder.size(), 18);
+
+  std::vector<std::vector<uint8_t>> segs;
+  encoder.gather([&](const uint8_t* buf, size_t size) { segs.emplace_back(buf, buf + size); });
+  ASSERT_EQ(segs.size(), 4);
+  EXPECT_THAT(segs[0], g::ElementsAreArray(test::fromHex("C205")));
+  EXPECT_EQ(segs[1], large);
+  EXPECT_THAT(segs[2], g::ElementsAreArray(test::fromHex("C102B0B1 C005")));
+  EXPECT_EQ(segs[3], large);
+
+  segs.clear();
+  encoder.gather(encoder.begin() + 7, encoder.begin() + 11,
+                 [&](const uint8_t* buf, size_t size) { segs.emplace_back(buf, buf + size); });
+  ASSERT_EQ(segs.size(), 1);
+  EXPECT_THAT(segs[0], g::ElementsAreArray(test::fromHex("C102B0B1")));
+
+  encoder.fillRefs();
+  segs.clear();
+  encoder.gather([&](const uint8_t* buf, size_t size) { segs.emplace_back(buf, buf + size); });
+  ASSERT_EQ(segs.size(), 1);
+  EXPECT_THAT(std::vector<uint8_t>(encoder.begin(), encoder.end()),
+              g::ElementsAreArray(test::fromHex("C205D0D1D2D3D4 C102B0B1 C005D0D1D2D3D4")));
+}
+
 } // namespace
 } // namespace ndnph
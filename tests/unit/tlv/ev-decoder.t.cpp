@@ -171,5 +171,26 @@ TEST(EvDecoder, All)
   EXPECT_FALSE(it.hasError());
 }
 
+TEST(EvDecoder, CustomOrder)
+{
+  std::vector<uint32_t> types;
+  auto decode = [&](const char* hex) {
+    types.clear();
+    auto wire = test::fromHex(hex);
+    return EvDecoder::decodeValue(
+      Decoder(wire.data(), wire.size()),
+      EvDecoder::def<0xA1, false, 20>([&](const Decoder::Tlv& d) { types.push_back(d.type); }),
+      EvDecoder::def<0xA3, true, 10>([&](const Decoder::Tlv& d) { types.push_back(d.type); }),
+      EvDecoder::def<0xA5>([&](const Decoder::Tlv& d) { types.push_back(d.type); }));
+  };
+
+  EXPECT_TRUE(decode("A300 A300 A100 A500"));
+  EXPECT_THAT(types, g::ElementsAre(0xA3, 0xA3, 0xA1, 0xA5));
+  EXPECT_FALSE(decode("A100 A300")); // out of order critical
+  EXPECT_FALSE(decode("A500 A500")); // non-repeatable
+  EXPECT_TRUE(decode("A500"));
+  EXPECT_THAT(types, g::ElementsAre(0xA5));
+}
+
 } // namespace
 } // namespace ndnph
@@ -39,5 +39,33 @@ TEST(Tlv, WriteVarNum)
   EXPECT_THAT(room, g::ElementsAre(0xFE, 0xFF, 0xFF, 0xFF, 0xFF));
 }
 
+TEST(Tlv, TypeLength)
+{
+  static_assert(tlv::sizeofTlv(0x07, 0) == 2, "");
+  static_assert(tlv::sizeofTlv(0x07, 0xFC) == 0xFE, "");
+  static_assert(tlv::sizeofTlv(0x07, 0xFD) == 0x0101, "");
+  static_assert(tlv::sizeofTlv(0xFD, 0x10000) == 0x10008, "");
+
+  std::vector<uint8_t> room(10);
+  EXPECT_EQ(tlv::writeTypeLength(room.data(), 0x07, 0x02), 2);
+  EXPECT_THAT(std::vector<uint8_t>(room.begin(), room.begin() + 2), g::ElementsAre(0x07, 0x02));
+  EXPECT_EQ(tlv::writeTypeLength(room.data(), 0x0320, 0x0100), 6);
+  EXPECT_THAT(std::vector<uint8_t>(room.begin(), room.begin() + 6),
+              g::ElementsAre(0xFD, 0x03, 0x20, 0xFD, 0x01, 0x00));
+
+  uint32_t type = 0, length = 0;
+  EXPECT_EQ(tlv::readTypeLength(room.data(), 6, type, length), 6);
+  EXPECT_EQ(type, 0x0320);
+  EXPECT_EQ(length, 0x0100);
+  EXPECT_EQ(tlv::readTypeLength(room.data(), 5, type, length), 0);
+
+  auto wire = test::fromHex("07FD00FD");
+  EXPECT_EQ(tlv::readTypeLength(wire.data(), 4, type, length), 4);
+  EXPECT_EQ(type, 0x07);
+  EXPECT_EQ(length, 0xFD);
+  EXPECT_EQ(tlv::readTypeLength(wire.data(), 2, type, length), 0);
+  EXPECT_EQ(tlv::readTypeLength(wire.data(), 1, type, length), 0);
+}
+
 } // namespace
 } // namespace ndnph